@@ -0,0 +1,141 @@
+// Throughput benchmark for AESStateSSL at DuckDB block sizes.
+//
+// Every iteration mirrors what DuckDB does per encrypted block: create an encryption state from the factory,
+// initialize it with a fresh nonce, process the block and finalize (computing the tag for GCM). The pooled
+// factory is compared against states that allocate their own cipher context, and against a baseline that also
+// resolves the cipher by name for every state, as the extension did before caching the ciphers.
+//
+// Usage: webdavfs_crypto_benchmark [total_mb_per_run]
+
+#include "crypto.hpp"
+#include "duckdb/common/exception.hpp"
+
+#include <openssl/evp.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace duckdb;
+
+static constexpr idx_t KEY_LEN = 32;
+static constexpr idx_t TAG_LEN = 16;
+
+//! The encryption path before contexts were pooled and ciphers cached: every state allocates a context and looks its
+//! cipher up by name, so on OpenSSL 3 each initialization fetches the cipher implementation again
+class BaselineAESState {
+public:
+	explicit BaselineAESState(EncryptionTypes::CipherType cipher_p)
+	    : cipher(cipher_p), context(EVP_CIPHER_CTX_new()),
+	      evp_cipher(EVP_get_cipherbyname(cipher_p == EncryptionTypes::GCM ? "aes-256-gcm" : "aes-256-ctr")) {
+		if (!context || !evp_cipher) {
+			throw InternalException("Failed to initialize the baseline AES state");
+		}
+	}
+	~BaselineAESState() {
+		EVP_CIPHER_CTX_free(context);
+	}
+
+	void InitializeEncryption(const_data_ptr_t iv, idx_t iv_len, const_data_ptr_t key, idx_t key_len,
+	                          const_data_ptr_t aad, idx_t aad_len) {
+		if (1 != EVP_EncryptInit_ex(context, evp_cipher, nullptr, nullptr, nullptr)) {
+			throw InternalException("EncryptInit failed");
+		}
+		if (cipher == EncryptionTypes::GCM &&
+		    1 != EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_GCM_SET_IVLEN, static_cast<int>(iv_len), nullptr)) {
+			throw InternalException("Setting the GCM IV length failed");
+		}
+		if (1 != EVP_EncryptInit_ex(context, nullptr, nullptr, key, iv)) {
+			throw InternalException("EncryptInit failed to set key/iv");
+		}
+	}
+
+	size_t Process(const_data_ptr_t in, idx_t in_len, data_ptr_t out, idx_t out_len) {
+		int written = 0;
+		if (1 != EVP_EncryptUpdate(context, out, &written, in, static_cast<int>(in_len))) {
+			throw InternalException("EncryptUpdate failed");
+		}
+		return static_cast<size_t>(written);
+	}
+
+	size_t Finalize(data_ptr_t out, idx_t out_len, data_ptr_t tag, idx_t tag_len) {
+		int written = 0;
+		if (1 != EVP_EncryptFinal_ex(context, out + out_len, &written)) {
+			throw InternalException("EncryptFinal failed");
+		}
+		if (cipher == EncryptionTypes::GCM &&
+		    1 != EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_GCM_GET_TAG, static_cast<int>(tag_len), tag)) {
+			throw InternalException("Calculating the tag failed");
+		}
+		return out_len + static_cast<size_t>(written);
+	}
+
+private:
+	EncryptionTypes::CipherType cipher;
+	EVP_CIPHER_CTX *context;
+	const EVP_CIPHER *evp_cipher;
+};
+
+struct BenchmarkResult {
+	double gb_per_second;
+	idx_t blocks;
+};
+
+template <class CREATE_STATE>
+static BenchmarkResult RunBenchmark(EncryptionTypes::CipherType cipher, idx_t block_size, idx_t total_bytes,
+                                    CREATE_STATE &&create_state) {
+	std::vector<data_t> key(KEY_LEN, 0x42);
+	std::vector<data_t> nonce(16, 0);
+	std::vector<data_t> input(block_size, 0x17);
+	std::vector<data_t> output(block_size + 16);
+	data_t tag[TAG_LEN];
+
+	// GCM uses a 12 byte nonce, CTR a full 16 byte counter block
+	idx_t nonce_len = cipher == EncryptionTypes::GCM ? 12 : 16;
+	idx_t blocks = MaxValue<idx_t>(total_bytes / block_size, 1);
+
+	auto start = std::chrono::steady_clock::now();
+	for (idx_t i = 0; i < blocks; i++) {
+		auto state = create_state(cipher);
+		nonce[0] = static_cast<data_t>(i);
+		state->InitializeEncryption(nonce.data(), nonce_len, key.data(), KEY_LEN, nullptr, 0);
+		auto written = state->Process(input.data(), block_size, output.data(), output.size());
+		state->Finalize(output.data(), written, tag, TAG_LEN);
+	}
+	auto end = std::chrono::steady_clock::now();
+
+	double seconds = std::chrono::duration<double>(end - start).count();
+	double bytes = static_cast<double>(blocks) * static_cast<double>(block_size);
+	return {bytes / seconds / 1e9, blocks};
+}
+
+int main(int argc, char **argv) {
+	idx_t total_mb = argc > 1 ? static_cast<idx_t>(std::strtoull(argv[1], nullptr, 10)) : 1024;
+	idx_t total_bytes = total_mb * 1024 * 1024;
+
+	// 16 KiB (minimum block size), 256 KiB (default block size) and 1 MiB
+	const idx_t block_sizes[] = {16384, 262144, 1048576};
+	const EncryptionTypes::CipherType ciphers[] = {EncryptionTypes::GCM, EncryptionTypes::CTR};
+
+	AESStateSSLFactory factory;
+
+	printf("%-6s %12s %14s %14s %14s %10s\n", "cipher", "block_size", "pooled GB/s", "unpooled GB/s",
+	       "baseline GB/s", "blocks");
+	for (auto cipher : ciphers) {
+		for (auto block_size : block_sizes) {
+			auto pooled = RunBenchmark(cipher, block_size, total_bytes, [&](EncryptionTypes::CipherType c) {
+				return factory.CreateEncryptionState(c, KEY_LEN);
+			});
+			auto unpooled = RunBenchmark(cipher, block_size, total_bytes, [&](EncryptionTypes::CipherType c) {
+				return make_shared_ptr<AESStateSSL>(c, KEY_LEN);
+			});
+			auto baseline = RunBenchmark(cipher, block_size, total_bytes,
+			                             [&](EncryptionTypes::CipherType c) { return make_uniq<BaselineAESState>(c); });
+			printf("%-6s %12llu %14.3f %14.3f %14.3f %10llu\n", cipher == EncryptionTypes::GCM ? "GCM" : "CTR",
+			       static_cast<unsigned long long>(block_size), pooled.gb_per_second, unpooled.gb_per_second,
+			       baseline.gb_per_second, static_cast<unsigned long long>(pooled.blocks));
+		}
+	}
+	return 0;
+}
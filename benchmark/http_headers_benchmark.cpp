@@ -0,0 +1,141 @@
+// Benchmark of the curl client's response header handling.
+//
+// Feeds the header lines of a typical range GET response through the header callback logic the way curl does, once
+// with the previous implementation (a std::string per line, substr splits, a fresh HTTPHeaders per response, stoi for
+// Content-Length and a copy into the HTTPResponse) and once with CURLResponseHeaders. Allocations are counted by
+// replacing the global operator new.
+//
+// Usage: webdavfs_http_headers_benchmark [responses]
+
+#include "httpfs_curl_client.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+static std::atomic<size_t> allocation_count {0};
+
+void *operator new(size_t size) {
+	allocation_count++;
+	if (auto ptr = malloc(size ? size : 1)) {
+		return ptr;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept {
+	free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+	free(ptr);
+}
+
+using namespace duckdb;
+
+static const char *const RESPONSE_LINES[] = {"HTTP/1.1 206 Partial Content\r\n",
+                                             "Date: Mon, 19 Oct 2026 10:00:00 GMT\r\n",
+                                             "Server: Apache/2.4.62 (Debian)\r\n",
+                                             "Last-Modified: Sun, 18 Oct 2026 22:14:03 GMT\r\n",
+                                             "ETag: \"4c1a2b-5f3e8a1c2b400\"\r\n",
+                                             "Accept-Ranges: bytes\r\n",
+                                             "Content-Length: 1000000\r\n",
+                                             "Content-Range: bytes 3000000-3999999/5000000000\r\n",
+                                             "Strict-Transport-Security: max-age=63072000\r\n",
+                                             "X-Content-Type-Options: nosniff\r\n",
+                                             "Keep-Alive: timeout=5, max=100\r\n",
+                                             "Connection: Keep-Alive\r\n",
+                                             "Content-Type: application/octet-stream\r\n",
+                                             "\r\n"};
+
+// The header callback as it was before CURLResponseHeaders
+static void LegacyHeaderCallback(const char *contents, size_t total_size, std::vector<HTTPHeaders> &collection) {
+	std::string header(contents, total_size);
+	if (!header.empty() && header.back() == '\n') {
+		header.pop_back();
+		if (!header.empty() && header.back() == '\r') {
+			header.pop_back();
+		}
+	}
+	if (header.rfind("HTTP/", 0) == 0) {
+		collection.push_back(HTTPHeaders());
+		collection.back().Insert("__RESPONSE_STATUS__", header);
+	}
+	size_t colon_pos = header.find(':');
+	if (colon_pos != std::string::npos) {
+		std::string part1 = header.substr(0, colon_pos);
+		std::string part2 = header.substr(colon_pos + 1);
+		if (!part2.empty() && part2.at(0) == ' ') {
+			part2.erase(0, 1);
+		}
+		collection.back().Insert(part1, part2);
+	}
+}
+
+struct BenchmarkResult {
+	double ns_per_response;
+	double allocations_per_response;
+};
+
+template <class FUNC>
+static BenchmarkResult Run(idx_t responses, FUNC &&process_response) {
+	auto allocations_before = allocation_count.load();
+	auto start = std::chrono::steady_clock::now();
+	for (idx_t i = 0; i < responses; i++) {
+		process_response();
+	}
+	auto end = std::chrono::steady_clock::now();
+	auto allocations = allocation_count.load() - allocations_before;
+	double ns = std::chrono::duration<double, std::nano>(end - start).count();
+	return {ns / static_cast<double>(responses), static_cast<double>(allocations) / static_cast<double>(responses)};
+}
+
+int main(int argc, char **argv) {
+	idx_t responses = argc > 1 ? static_cast<idx_t>(std::strtoull(argv[1], nullptr, 10)) : 1000000;
+	std::vector<std::pair<const char *, size_t>> lines;
+	for (auto line : RESPONSE_LINES) {
+		lines.emplace_back(line, strlen(line));
+	}
+
+	idx_t checksum = 0;
+	std::vector<HTTPHeaders> collection;
+	auto legacy = Run(responses, [&]() {
+		for (auto &line : lines) {
+			LegacyHeaderCallback(line.first, line.second, collection);
+		}
+		HTTPResponse response(HTTPStatusCode::PartialContent_206);
+		for (auto &header : collection.back()) {
+			response.headers.Insert(header.first, header.second);
+		}
+		if (collection.back().HasHeader("content-length")) {
+			checksum += static_cast<idx_t>(std::stoi(collection.back().GetHeaderValue("content-length")));
+		}
+		collection.clear();
+	});
+
+	CURLResponseHeaders headers;
+	auto lean = Run(responses, [&]() {
+		for (auto &line : lines) {
+			headers.ParseLine(line.first, line.second);
+		}
+		HTTPResponse response(HTTPStatusCode::PartialContent_206);
+		headers.AddTo(response.headers);
+		idx_t content_length;
+		if (headers.TryGetContentLength(content_length)) {
+			checksum += content_length;
+		}
+		headers.Reset();
+	});
+
+	printf("%-22s %14s %18s\n", "implementation", "ns/response", "allocs/response");
+	printf("%-22s %14.1f %18.1f\n", "legacy", legacy.ns_per_response, legacy.allocations_per_response);
+	printf("%-22s %14.1f %18.1f\n", "CURLResponseHeaders", lean.ns_per_response, lean.allocations_per_response);
+	printf("speedup: %.2fx (checksum %llu)\n", legacy.ns_per_response / lean.ns_per_response,
+	       static_cast<unsigned long long>(checksum));
+	return 0;
+}
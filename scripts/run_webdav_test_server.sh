@@ -19,3 +19,4 @@ done
 
 export WEBDAV_TEST_SERVER_AVAILABLE=1
 export WEBDAV_TEST_BASE_URL="webdav://localhost:9100"
+export WEBDAV_SABREDAV_TEST_BASE_URL="webdav://localhost:9101"
@@ -0,0 +1,17 @@
+<?php
+// SabreDAV test server with the partial update plugin (PATCH with X-Update-Range), used by the tests of
+// read-write attached databases. Served with PHP's built-in web server, see scripts/webdav.yml.
+
+require '/srv/sabredav/vendor/autoload.php';
+
+$root = new \Sabre\DAV\FSExt\Directory('/srv/sabredav/data');
+$server = new \Sabre\DAV\Server($root);
+$server->setBaseUri('/');
+
+$auth = new \Sabre\DAV\Auth\Backend\BasicCallBack(function ($username, $password) {
+    return $username === 'duckdb_webdav_user' && $password === 'duckdb_webdav_password';
+});
+$server->addPlugin(new \Sabre\DAV\Auth\Plugin($auth));
+$server->addPlugin(new \Sabre\DAV\PartialUpdate\Plugin());
+
+$server->start();
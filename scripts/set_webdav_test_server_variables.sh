@@ -9,3 +9,6 @@ export WEBDAV_TEST_SERVER_AVAILABLE=1
 export WEBDAV_TEST_USERNAME=duckdb_webdav_user
 export WEBDAV_TEST_PASSWORD=duckdb_webdav_password
 export WEBDAV_TEST_BASE_URL=webdav://localhost:9100
+
+# SabreDAV server with partial update (PATCH) support
+export WEBDAV_SABREDAV_TEST_BASE_URL=webdav://localhost:9101
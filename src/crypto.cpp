@@ -23,8 +23,42 @@
 
 namespace duckdb {
 
-AESStateSSL::AESStateSSL(EncryptionTypes::CipherType cipher_p, idx_t key_len)
-    : EncryptionState(cipher_p, key_len), context(EVP_CIPHER_CTX_new()) {
+AESContextPool::~AESContextPool() {
+	for (auto context : contexts) {
+		EVP_CIPHER_CTX_free(context);
+	}
+}
+
+EVP_CIPHER_CTX *AESContextPool::Acquire() {
+	{
+		lock_guard<mutex> guard(lock);
+		if (!contexts.empty()) {
+			auto context = contexts.back();
+			contexts.pop_back();
+			return context;
+		}
+	}
+	return EVP_CIPHER_CTX_new();
+}
+
+void AESContextPool::Release(EVP_CIPHER_CTX *context) {
+	if (!context) {
+		return;
+	}
+	// Resetting wipes the key material and cipher state but keeps the allocation around
+	if (1 == EVP_CIPHER_CTX_reset(context)) {
+		lock_guard<mutex> guard(lock);
+		if (contexts.size() < MAX_POOLED_CONTEXTS) {
+			contexts.push_back(context);
+			return;
+		}
+	}
+	EVP_CIPHER_CTX_free(context);
+}
+
+AESStateSSL::AESStateSSL(EncryptionTypes::CipherType cipher_p, idx_t key_len, shared_ptr<AESContextPool> pool_p)
+    : EncryptionState(cipher_p, key_len), pool(std::move(pool_p)),
+      context(pool ? pool->Acquire() : EVP_CIPHER_CTX_new()) {
 	if (!(context)) {
 		throw InternalException("OpenSSL AES failed with initializing context");
 	}
@@ -32,47 +66,87 @@ AESStateSSL::AESStateSSL(EncryptionTypes::CipherType cipher_p, idx_t key_len)
 
 AESStateSSL::~AESStateSSL() {
 	// Clean up
-	EVP_CIPHER_CTX_free(context);
+	if (pool) {
+		pool->Release(context);
+	} else {
+		EVP_CIPHER_CTX_free(context);
+	}
+}
+
+//! Resolve a cipher once. On OpenSSL 3 the legacy EVP_aes_*() objects trigger an implicit provider fetch (which takes
+//! a global lock) every time a context is initialized with them, so we explicitly fetch and keep them instead.
+static const EVP_CIPHER *LoadCipher(const char *name, const EVP_CIPHER *legacy_cipher) {
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+	auto fetched = EVP_CIPHER_fetch(nullptr, name, nullptr);
+	if (fetched) {
+		return fetched;
+	}
+#endif
+	return legacy_cipher;
+}
+
+//! Process-wide cache of the AES ciphers, indexed by key length (16, 24 or 32 bytes)
+struct AESCipherCache {
+	AESCipherCache() {
+		gcm[0] = LoadCipher("AES-128-GCM", EVP_aes_128_gcm());
+		gcm[1] = LoadCipher("AES-192-GCM", EVP_aes_192_gcm());
+		gcm[2] = LoadCipher("AES-256-GCM", EVP_aes_256_gcm());
+		ctr[0] = LoadCipher("AES-128-CTR", EVP_aes_128_ctr());
+		ctr[1] = LoadCipher("AES-192-CTR", EVP_aes_192_ctr());
+		ctr[2] = LoadCipher("AES-256-CTR", EVP_aes_256_ctr());
+		cbc[0] = LoadCipher("AES-128-CBC", EVP_aes_128_cbc());
+		cbc[1] = LoadCipher("AES-192-CBC", EVP_aes_192_cbc());
+		cbc[2] = LoadCipher("AES-256-CBC", EVP_aes_256_cbc());
+	}
+
+	const EVP_CIPHER *gcm[3];
+	const EVP_CIPHER *ctr[3];
+	const EVP_CIPHER *cbc[3];
+};
+
+static const AESCipherCache &GetCipherCache() {
+	static AESCipherCache cache;
+	return cache;
+}
+
+static bool TryGetKeyIndex(idx_t key_len, idx_t &index) {
+	switch (key_len) {
+	case 16:
+		index = 0;
+		return true;
+	case 24:
+		index = 1;
+		return true;
+	case 32:
+		index = 2;
+		return true;
+	default:
+		return false;
+	}
 }
 
 const EVP_CIPHER *AESStateSSL::GetCipher(idx_t key_len) {
+	auto &cache = GetCipherCache();
+	idx_t index;
 
 	switch (cipher) {
 	case EncryptionTypes::GCM: {
-		switch (key_len) {
-		case 16:
-			return EVP_aes_128_gcm();
-		case 24:
-			return EVP_aes_192_gcm();
-		case 32:
-			return EVP_aes_256_gcm();
-		default:
+		if (!TryGetKeyIndex(key_len, index)) {
 			throw InternalException("Invalid AES key length for GCM");
 		}
+		return cache.gcm[index];
 	}
 	case EncryptionTypes::CTR: {
-		switch (key_len) {
-		case 16:
-			return EVP_aes_128_ctr();
-		case 24:
-			return EVP_aes_192_ctr();
-		case 32:
-			return EVP_aes_256_ctr();
-		default:
+		if (!TryGetKeyIndex(key_len, index)) {
 			throw InternalException("Invalid AES key length for CTR");
 		}
+		return cache.ctr[index];
 	}
 	case EncryptionTypes::CBC: {
-		switch (key_len) {
-		case 16:
-			return EVP_aes_128_cbc();
-		case 24:
-			return EVP_aes_192_cbc();
-		case 32:
-			return EVP_aes_256_cbc();
-		default:
+		if (!TryGetKeyIndex(key_len, index)) {
 			throw InternalException("Invalid AES key length for CBC");
 		}
+		return cache.cbc[index];
 	}
 	default:
 		throw InternalException("Invalid Encryption/Decryption Cipher: %d", static_cast<int>(cipher));
@@ -94,8 +168,11 @@ void AESStateSSL::InitializeEncryption(const_data_ptr_t iv, idx_t iv_len, const_
 	if (1 != EVP_EncryptInit_ex(context, GetCipher(key_len), NULL, NULL, NULL)) {
 		throw InternalException("EncryptInit failed (attempt 1)");
 	}
-	if (1 != EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_GCM_SET_IVLEN, iv_len, NULL)) {
-		throw InternalException("EVP_CIPHER_CTX_ctrl failed (EVP_CTRL_GCM_SET_IVLEN)");
+	// we use a bigger IV for GCM
+	if (cipher == EncryptionTypes::GCM) {
+		if (1 != EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_GCM_SET_IVLEN, iv_len, NULL)) {
+			throw InternalException("EVP_CIPHER_CTX_ctrl failed (EVP_CTRL_GCM_SET_IVLEN)");
+		}
 	}
 
 	if (1 != EVP_EncryptInit_ex(context, NULL, NULL, key, iv)) {
@@ -104,7 +181,7 @@ void AESStateSSL::InitializeEncryption(const_data_ptr_t iv, idx_t iv_len, const_
 
 	int len;
 	if (aad_len > 0) {
-		if (!EVP_DecryptUpdate(context, NULL, &len, aad, aad_len)) {
+		if (!EVP_EncryptUpdate(context, NULL, &len, aad, aad_len)) {
 			throw InternalException("Setting Additional Authenticated Data  failed");
 		}
 	}
@@ -137,27 +214,34 @@ void AESStateSSL::InitializeDecryption(const_data_ptr_t iv, idx_t iv_len, const_
 }
 
 size_t AESStateSSL::Process(const_data_ptr_t in, idx_t in_len, data_ptr_t out, idx_t out_len) {
-	switch (mode) {
-	case EncryptionTypes::ENCRYPT:
-		if (1 != EVP_EncryptUpdate(context, data_ptr_cast(out), reinterpret_cast<int *>(&out_len),
-		                           const_data_ptr_cast(in), (int)in_len)) {
-			throw InternalException("EncryptUpdate failed");
+	// Callers may hand us many blocks at once; EVP only takes int lengths, so feed it in bounded slices
+	idx_t processed = 0;
+	while (processed < in_len) {
+		auto slice_len = MinValue<idx_t>(in_len - processed, MAX_UPDATE_SIZE);
+		int written = 0;
+		switch (mode) {
+		case EncryptionTypes::ENCRYPT:
+			if (1 != EVP_EncryptUpdate(context, data_ptr_cast(out + processed), &written,
+			                           const_data_ptr_cast(in + processed), static_cast<int>(slice_len))) {
+				throw InternalException("EncryptUpdate failed");
+			}
+			break;
+
+		case EncryptionTypes::DECRYPT:
+			if (1 != EVP_DecryptUpdate(context, data_ptr_cast(out + processed), &written,
+			                           const_data_ptr_cast(in + processed), static_cast<int>(slice_len))) {
+
+				throw InternalException("DecryptUpdate failed");
+			}
+			break;
 		}
-		break;
-
-	case EncryptionTypes::DECRYPT:
-		if (1 != EVP_DecryptUpdate(context, data_ptr_cast(out), reinterpret_cast<int *>(&out_len),
-		                           const_data_ptr_cast(in), (int)in_len)) {
 
-			throw InternalException("DecryptUpdate failed");
+		if (static_cast<idx_t>(written) != slice_len) {
+			throw InternalException("AES GCM failed, in- and output lengths differ");
 		}
-		break;
-	}
-
-	if (out_len != in_len) {
-		throw InternalException("AES GCM failed, in- and output lengths differ");
+		processed += slice_len;
 	}
-	return out_len;
+	return processed;
 }
 
 size_t AESStateSSL::FinalizeGCM(data_ptr_t out, idx_t out_len, data_ptr_t tag, idx_t tag_len) {
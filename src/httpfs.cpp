@@ -62,6 +62,11 @@ unique_ptr<HTTPParams> HTTPFSUtil::InitializeParameters(optional_ptr<FileOpener>
 	FileOpener::TryGetCurrentSetting(opener, "webdav_max_retries", result->webdav_max_retries, info);
 	FileOpener::TryGetCurrentSetting(opener, "webdav_streaming_threshold_mb", result->webdav_streaming_threshold_mb,
 	                                 info);
+	FileOpener::TryGetCurrentSetting(opener, "webdav_upload_threads", result->webdav_upload_threads, info);
+	FileOpener::TryGetCurrentSetting(opener, "webdav_listing_cache", result->webdav_listing_cache, info);
+	FileOpener::TryGetCurrentSetting(opener, "webdav_partial_update", result->webdav_partial_update, info);
+	FileOpener::TryGetCurrentSetting(opener, "webdav_block_store_directory", result->webdav_block_store_directory,
+	                                 info);
 
 	{
 		auto db = FileOpener::TryGetDatabase(opener);
@@ -623,7 +628,7 @@ optional_ptr<HTTPMetadataCache> HTTPFileSystem::GetGlobalCache() {
 }
 
 // Get either the local, global, or no cache depending on settings
-static optional_ptr<HTTPMetadataCache> TryGetMetadataCache(optional_ptr<FileOpener> opener, HTTPFileSystem &httpfs) {
+optional_ptr<HTTPMetadataCache> HTTPFileSystem::TryGetMetadataCache(optional_ptr<FileOpener> opener) {
 	auto db = FileOpener::TryGetDatabase(opener);
 	auto client_context = FileOpener::TryGetClientContext(opener);
 	if (!db) {
@@ -632,7 +637,7 @@ static optional_ptr<HTTPMetadataCache> TryGetMetadataCache(optional_ptr<FileOpen
 
 	bool use_shared_cache = db->config.options.http_metadata_cache_enable;
 	if (use_shared_cache) {
-		return httpfs.GetGlobalCache();
+		return GetGlobalCache();
 	} else if (client_context) {
 		return client_context->registered_state->GetOrCreate<HTTPMetadataCache>("http_cache", true, true).get();
 	}
@@ -784,7 +789,7 @@ void HTTPFileHandle::Initialize(optional_ptr<FileOpener> opener) {
 		TryAddLogger(*opener);
 	}
 
-	auto current_cache = TryGetMetadataCache(opener, hfs);
+	auto current_cache = hfs.TryGetMetadataCache(opener);
 
 	bool should_write_cache = false;
 	if (flags.OpenForReading()) {
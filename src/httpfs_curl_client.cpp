@@ -8,6 +8,8 @@
 #include <thread>
 #include <chrono>
 #include "duckdb/common/exception/http_exception.hpp"
+#include "duckdb/common/limits.hpp"
+#include "duckdb/common/string_util.hpp"
 
 #ifndef EMSCRIPTEN
 #include "httpfs_curl_client.hpp"
@@ -119,11 +121,90 @@ static std::string SelectCURLCertPath() {
 
 static std::string cert_path = SelectCURLCertPath();
 
+static bool HeaderNameEquals(const char *name, idx_t name_length, const char *expected) {
+	idx_t i = 0;
+	for (; i < name_length; i++) {
+		if (expected[i] == '\0' || StringUtil::CharacterToLower(name[i]) != StringUtil::CharacterToLower(expected[i])) {
+			return false;
+		}
+	}
+	return expected[i] == '\0';
+}
+
+void CURLResponseHeaders::ParseLine(const char *line, idx_t length) {
+	while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r')) {
+		length--;
+	}
+	// A status line starts the headers of a new response, e.g. after following a redirect
+	if (length >= 5 && memcmp(line, "HTTP/", 5) == 0) {
+		Reset();
+		status_line.assign(line, length);
+		return;
+	}
+	auto colon = static_cast<const char *>(memchr(line, ':', length));
+	if (!colon) {
+		// the empty line ending the headers, or a malformed line
+		return;
+	}
+	auto value = colon + 1;
+	auto value_end = line + length;
+	while (value < value_end && (*value == ' ' || *value == '\t')) {
+		value++;
+	}
+	while (value_end > value && (value_end[-1] == ' ' || value_end[-1] == '\t')) {
+		value_end--;
+	}
+	if (header_count == headers.size()) {
+		headers.emplace_back();
+	}
+	// assign() reuses the capacity left by earlier responses
+	auto &header = headers[header_count++];
+	header.first.assign(line, static_cast<idx_t>(colon - line));
+	header.second.assign(value, static_cast<idx_t>(value_end - value));
+}
+
+void CURLResponseHeaders::Reset() {
+	status_line.clear();
+	header_count = 0;
+}
+
+const string *CURLResponseHeaders::Find(const char *name) const {
+	for (idx_t i = 0; i < header_count; i++) {
+		auto &header = headers[i];
+		if (HeaderNameEquals(header.first.c_str(), header.first.size(), name)) {
+			return &header.second;
+		}
+	}
+	return nullptr;
+}
+
+bool CURLResponseHeaders::TryGetContentLength(idx_t &result) const {
+	auto content_length = Find("Content-Length");
+	if (!content_length || content_length->empty()) {
+		return false;
+	}
+	idx_t value = 0;
+	for (auto c : *content_length) {
+		if (!StringUtil::CharacterIsDigit(c) || value > (NumericLimits<idx_t>::Maximum() - 9) / 10) {
+			return false;
+		}
+		value = value * 10 + static_cast<idx_t>(c - '0');
+	}
+	result = value;
+	return true;
+}
+
+void CURLResponseHeaders::AddTo(HTTPHeaders &result) const {
+	for (idx_t i = 0; i < header_count; i++) {
+		result.Insert(headers[i].first, headers[i].second);
+	}
+}
+
 struct RequestInfo {
 	string url = "";
 	string body = "";
 	uint16_t response_code = 0;
-	std::vector<HTTPHeaders> header_collection;
+	CURLResponseHeaders response_headers;
 	// For custom HTTP methods with body
 	string read_buffer = "";
 	size_t read_position = 0;
@@ -210,38 +291,8 @@ static size_t ReadCallbackFile(char *buffer, size_t size, size_t nitems, void *u
 
 static size_t RequestHeaderCallback(void *contents, size_t size, size_t nmemb, void *userp) {
 	size_t totalSize = size * nmemb;
-	std::string header(static_cast<char *>(contents), totalSize);
-	HeaderCollector *header_collection = static_cast<HeaderCollector *>(userp);
-
-	// Trim trailing \r\n
-	if (!header.empty() && header.back() == '\n') {
-		header.pop_back();
-		if (!header.empty() && header.back() == '\r') {
-			header.pop_back();
-		}
-	}
-
-	// If header starts with HTTP/... curl has followed a redirect and we have a new Header,
-	// so we push back a new header_collection and store headers from the redirect there.
-	if (header.rfind("HTTP/", 0) == 0) {
-		header_collection->header_collection.push_back(HTTPHeaders());
-		header_collection->header_collection.back().Insert("__RESPONSE_STATUS__", header);
-	}
-
-	size_t colonPos = header.find(':');
-
-	if (colonPos != std::string::npos) {
-		// Split the string into two parts
-		std::string part1 = header.substr(0, colonPos);
-		std::string part2 = header.substr(colonPos + 1);
-		if (part2.at(0) == ' ') {
-			part2.erase(0, 1);
-		}
-
-		header_collection->header_collection.back().Insert(part1, part2);
-	}
-	// TODO: log headers that don't follow the header format
-
+	auto response_headers = static_cast<CURLResponseHeaders *>(userp);
+	response_headers->ParseLine(static_cast<const char *>(contents), totalSize);
 	return totalSize;
 }
 
@@ -335,7 +386,7 @@ public:
 
 		// define the header callback
 		curl_easy_setopt(*curl, CURLOPT_HEADERFUNCTION, RequestHeaderCallback);
-		curl_easy_setopt(*curl, CURLOPT_HEADERDATA, &request_info->header_collection);
+		curl_easy_setopt(*curl, CURLOPT_HEADERDATA, &request_info->response_headers);
 		// define the write data callback (for get requests)
 		curl_easy_setopt(*curl, CURLOPT_WRITEFUNCTION, RequestWriteCallback);
 		curl_easy_setopt(*curl, CURLOPT_WRITEDATA, &request_info->body);
@@ -381,23 +432,20 @@ public:
 			res = ExecuteWithRetry();
 		}
 
-		idx_t bytes_received = 0;
-		if (!request_info->header_collection.empty() &&
-		    request_info->header_collection.back().HasHeader("content-length")) {
-			bytes_received = std::stoi(request_info->header_collection.back().GetHeaderValue("content-length"));
-			D_ASSERT(bytes_received == request_info->body.size());
-		} else {
+		// Content-Length counts the bytes on the wire, which differ from the body when it was compressed
+		idx_t bytes_received;
+		if (!request_info->response_headers.TryGetContentLength(bytes_received)) {
 			bytes_received = request_info->body.size();
 		}
 		if (state) {
 			state->total_bytes_received += bytes_received;
 		}
 
-		const char *data = request_info->body.c_str();
 		if (info.content_handler) {
-			info.content_handler(const_data_ptr_cast(data), bytes_received);
+			info.content_handler(const_data_ptr_cast(request_info->body.data()), request_info->body.size());
+			// The content was handed over: keep the body buffer for the next request instead of copying it
+			return TransformResponseCurl(res, false);
 		}
-
 		return TransformResponseCurl(res);
 	}
 
@@ -542,8 +590,10 @@ public:
 		}
 
 		auto curl_headers = TransformHeadersCurl(info.headers);
-		const string content_type = "Content-Type: application/octet-stream";
-		curl_headers.Add(content_type.c_str());
+		// Custom methods may send a body of another type (e.g. PATCH with a partial update)
+		if (!info.headers.HasHeader("Content-Type")) {
+			curl_headers.Add("Content-Type: application/octet-stream");
+		}
 
 		// Disable "Expect: 100-continue" for large uploads to avoid HTTP 100 Continue errors
 		// Some WebDAV servers (like Hetzner Storage Box) don't handle this well for large files
@@ -611,20 +661,20 @@ public:
 			res = ExecuteWithRetry();
 		}
 
-		info.buffer_out = request_info->body;
-		// Construct HTTPResponse
-		return TransformResponseCurl(res);
+		info.buffer_out = std::move(request_info->body);
+		// Construct HTTPResponse, the body was moved to the output buffer
+		return TransformResponseCurl(res, false);
 	}
 
 private:
 	CURLRequestHeaders TransformHeadersCurl(const HTTPHeaders &header_map) {
-		std::vector<std::string> headers;
-		for (auto &entry : header_map) {
-			const std::string new_header = entry.first + ": " + entry.second;
-			headers.push_back(new_header);
-		}
 		CURLRequestHeaders curl_headers;
-		for (auto &header : headers) {
+		string header;
+		for (auto &entry : header_map) {
+			// curl copies the header, so a single buffer serves all of them
+			header.assign(entry.first);
+			header += ": ";
+			header += entry.second;
 			curl_headers.Add(header);
 		}
 		return curl_headers;
@@ -651,11 +701,15 @@ private:
 	}
 
 	void ResetRequestInfo() {
-		// clear headers after transform
-		request_info->header_collection.clear();
-		// reset request info.
-		request_info->body = "";
-		request_info->url = "";
+		// clear headers after transform, keeping the buffers
+		request_info->response_headers.Reset();
+		// reset request info. Very large bodies (full downloads) are released rather than kept around
+		if (request_info->body.capacity() > MAX_RETAINED_BODY_CAPACITY) {
+			string().swap(request_info->body);
+		} else {
+			request_info->body.clear();
+		}
+		request_info->url.clear();
 		request_info->response_code = 0;
 		// reset upload file for streaming
 		request_info->upload_file = nullptr;
@@ -665,26 +719,26 @@ private:
 		request_info->last_progress_percent = -1;
 	}
 
-	unique_ptr<HTTPResponse> TransformResponseCurl(CURLcode res) {
+	//! Build the response of the last request. The body is moved into it when 'include_body' is set.
+	unique_ptr<HTTPResponse> TransformResponseCurl(CURLcode res, bool include_body = true) {
 		auto status_code = HTTPStatusCode(request_info->response_code);
 		auto response = make_uniq<HTTPResponse>(status_code);
 		if (res != CURLcode::CURLE_OK) {
 			// TODO: request error can come from HTTPS Status code toString() value.
-			if (!request_info->header_collection.empty() &&
-			    request_info->header_collection.back().HasHeader("__RESPONSE_STATUS__")) {
-				response->request_error = request_info->header_collection.back().GetHeaderValue("__RESPONSE_STATUS__");
+			if (!request_info->response_headers.StatusLine().empty()) {
+				response->request_error = request_info->response_headers.StatusLine();
 			} else {
 				response->request_error = curl_easy_strerror(res);
 			}
+			// do not leak headers or body of a failed request into the next one
+			ResetRequestInfo();
 			return response;
 		}
-		response->body = request_info->body;
-		response->url = request_info->url;
-		if (!request_info->header_collection.empty()) {
-			for (auto &header : request_info->header_collection.back()) {
-				response->headers.Insert(header.first, header.second);
-			}
+		if (include_body) {
+			response->body = std::move(request_info->body);
 		}
+		response->url = request_info->url;
+		request_info->response_headers.AddTo(response->headers);
 		ResetRequestInfo();
 		return response;
 	}
@@ -735,8 +789,8 @@ private:
 				WEBDAV_DEBUG_LOG("[CURL RETRY] Request failed (reason: %s), retrying (attempt %d/%d)\n",
 				                 retry_reason.c_str(), attempt + 1, max_retries);
 
-				// Reset request info for retry (but preserve headers)
-				request_info->body = "";
+				// Reset the body for the retry; the headers are replaced when the next status line arrives
+				request_info->body.clear();
 				request_info->response_code = 0;
 
 				// Wait with exponential backoff before retrying
@@ -755,6 +809,8 @@ private:
 	optional_ptr<HTTPState> state;
 	unique_ptr<RequestInfo> request_info;
 	int max_retries = 3; // Maximum number of retries for transient failures
+	//! Body buffers up to this capacity are reused by the next request of the client
+	static constexpr idx_t MAX_RETAINED_BODY_CAPACITY = 16ULL * 1024 * 1024;
 
 	// Friend function for streaming upload support
 	friend void SetHTTPClientUploadFile(HTTPClient *client, FILE *fp, size_t size);
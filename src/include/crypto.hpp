@@ -2,6 +2,8 @@
 
 #include "duckdb/common/encryption_state.hpp"
 #include "duckdb/common/helper.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/vector.hpp"
 
 #include <stddef.h>
 #include <string>
@@ -22,10 +24,30 @@ void hmac256(std::string message, hash_bytes secret, hash_bytes &out);
 
 void hex256(hash_bytes &in, hash_str &out);
 
+//! Pool of OpenSSL cipher contexts, so encryption states do not allocate a fresh context per block
+class AESContextPool {
+public:
+	AESContextPool() = default;
+	~AESContextPool();
+
+	//! Get a context from the pool, allocating a new one if the pool is empty
+	EVP_CIPHER_CTX *Acquire();
+	//! Reset a context (wiping key material) and return it to the pool
+	void Release(EVP_CIPHER_CTX *context);
+
+	//! Contexts beyond this count are freed instead of pooled
+	static constexpr idx_t MAX_POOLED_CONTEXTS = 64;
+
+private:
+	mutex lock;
+	vector<EVP_CIPHER_CTX *> contexts;
+};
+
 class DUCKDB_EXTENSION_API AESStateSSL : public EncryptionState {
 
 public:
-	explicit AESStateSSL(EncryptionTypes::CipherType cipher_p, idx_t key_len_p);
+	explicit AESStateSSL(EncryptionTypes::CipherType cipher_p, idx_t key_len_p,
+	                     shared_ptr<AESContextPool> pool_p = nullptr);
 	~AESStateSSL() override;
 
 public:
@@ -40,7 +62,12 @@ public:
 	const EVP_CIPHER *GetCipher(idx_t key_len);
 	size_t FinalizeGCM(data_ptr_t out, idx_t out_len, data_ptr_t tag, idx_t tag_len);
 
+	//! Maximum number of bytes handed to a single EVP update call (EVP lengths are ints)
+	static constexpr idx_t MAX_UPDATE_SIZE = 1ULL << 30;
+
 private:
+	//! Pool the context is returned to on destruction (if any)
+	shared_ptr<AESContextPool> pool;
 	EVP_CIPHER_CTX *context;
 	EncryptionTypes::Mode mode;
 };
@@ -51,15 +78,19 @@ extern "C" {
 
 class DUCKDB_EXTENSION_API AESStateSSLFactory : public duckdb::EncryptionUtil {
 public:
-	explicit AESStateSSLFactory() {
+	explicit AESStateSSLFactory() : pool(duckdb::make_shared_ptr<duckdb::AESContextPool>()) {
 	}
 
 	duckdb::shared_ptr<duckdb::EncryptionState> CreateEncryptionState(duckdb::EncryptionTypes::CipherType cipher_p,
 	                                                                  duckdb::idx_t key_len_p) const override {
-		return duckdb::make_shared_ptr<duckdb::AESStateSSL>(cipher_p, key_len_p);
+		return duckdb::make_shared_ptr<duckdb::AESStateSSL>(cipher_p, key_len_p, pool);
 	}
 
 	~AESStateSSLFactory() override {
 	}
+
+private:
+	//! Cipher contexts shared by all states created by this factory
+	duckdb::shared_ptr<duckdb::AESContextPool> pool;
 };
 }
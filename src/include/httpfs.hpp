@@ -168,6 +168,8 @@ public:
 	static void Verify();
 
 	optional_ptr<HTTPMetadataCache> GetGlobalCache();
+	//! Get either the local, global, or no metadata cache depending on settings
+	optional_ptr<HTTPMetadataCache> TryGetMetadataCache(optional_ptr<FileOpener> opener);
 
 protected:
 	unique_ptr<FileHandle> OpenFileExtended(const OpenFileInfo &file, FileOpenFlags flags,
@@ -31,6 +31,10 @@ struct HTTPFSParams : public HTTPParams {
 	bool webdav_debug_logging = false;
 	uint64_t webdav_max_retries = 3;
 	uint64_t webdav_streaming_threshold_mb = 50;
+	uint64_t webdav_upload_threads = 2;
+	bool webdav_listing_cache = false;
+	string webdav_partial_update = "auto";
+	string webdav_block_store_directory;
 	// Additional fields needs to be appended at the end and need to be propagated to duckdb-wasm
 	// TODO: make this unnecessary
 };
@@ -56,8 +60,4 @@ public:
 	string GetName() const override;
 };
 
-struct HeaderCollector {
-	std::vector<HTTPHeaders> header_collection;
-};
-
 } // namespace duckdb
@@ -56,6 +56,35 @@ public:
 	curl_slist *headers = NULL;
 };
 
+//! Response headers collected by the curl header callback. Lines are parsed in place and every header is kept, in
+//! slots whose buffers are reused by the next response of the same client.
+class CURLResponseHeaders {
+public:
+	//! Process one line as passed to CURLOPT_HEADERFUNCTION (including the trailing CRLF)
+	void ParseLine(const char *line, idx_t length);
+	//! Forget the headers of the previous response, keeping the allocated buffers
+	void Reset();
+
+	//! The status line of the last response ("HTTP/1.1 206 Partial Content"), empty if none was received
+	const string &StatusLine() const {
+		return status_line;
+	}
+	//! Parse the Content-Length header as a 64-bit value
+	bool TryGetContentLength(idx_t &result) const;
+	//! Add the headers of the last response to 'headers'
+	void AddTo(HTTPHeaders &headers) const;
+
+private:
+	//! The value of header 'name' (case-insensitive), nullptr if the last response did not have it
+	const string *Find(const char *name) const;
+
+private:
+	string status_line;
+	//! Name and value of each header; only the first 'header_count' belong to the last response
+	vector<std::pair<string, string>> headers;
+	idx_t header_count = 0;
+};
+
 // Helper function for streaming uploads from file
 void SetHTTPClientUploadFile(HTTPClient *client, FILE *fp, size_t size);
 
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/http_util.hpp"
+#include "duckdb/common/mutex.hpp"
+
+namespace duckdb {
+
+class WebDAVFileHandle;
+
+//! How Sync uploads the changed ranges of a file
+enum class WebDAVPartialUpdateMode : uint8_t {
+	//! PATCH if the server advertises sabredav-partialupdate in OPTIONS, full upload otherwise
+	AUTO,
+	//! PATCH with X-Update-Range (SabreDAV partial update plugin)
+	PATCH,
+	//! PUT with a Content-Range header, only after a probe on a scratch file showed the server applies it
+	CONTENT_RANGE,
+	//! Always upload the whole file
+	NONE
+};
+
+//! Local sparse copy of a remote file that is opened for reading and writing, e.g. an attached database. Blocks are
+//! fetched with range requests the first time they are read, writes only go to the local copy, and Sync uploads the
+//! blocks written since the previous sync. The ETag of the remote file guards against overwriting changes made by
+//! other writers.
+class WebDAVBlockStore {
+public:
+	//! 'remote_size' is the size of the file on the server, 'remote_exists' is false when the file is being created.
+	//! With 'overwrite' the store starts empty and the first sync replaces the remote file.
+	WebDAVBlockStore(WebDAVFileHandle &handle, idx_t remote_size, bool remote_exists, const string &etag,
+	                 bool overwrite);
+	~WebDAVBlockStore();
+
+	void Read(void *buffer, idx_t nr_bytes, idx_t location);
+	void Write(const void *buffer, idx_t nr_bytes, idx_t location);
+	void Truncate(idx_t new_size);
+	idx_t GetSize();
+	//! Upload the blocks written since the last sync
+	void Sync();
+	//! Whether writes or a truncation happened since the last sync
+	bool HasUnsyncedChanges();
+
+	static WebDAVPartialUpdateMode ParsePartialUpdateMode(const string &mode);
+
+	//! Granularity of fetching and change tracking. DuckDB places its headers and blocks on 4 KiB boundaries, so
+	//! writing a database block dirties exactly that block.
+	static constexpr idx_t BLOCK_SIZE = 4096;
+	//! Largest range fetched or uploaded in one request
+	static constexpr idx_t MAX_TRANSFER_SIZE = 16ULL * 1024 * 1024;
+
+private:
+	//! Fetch the blocks overlapping [start, end) that were not read from the server yet
+	void FetchMissing(idx_t start, idx_t end);
+	void FetchBlocks(idx_t first_block, idx_t end_block);
+	//! Upload the dirty ranges one by one; returns false if the server rejected the first one (nothing was changed).
+	//! 'requests' and 'bytes' count what was sent.
+	bool UploadRanges(WebDAVPartialUpdateMode mode, idx_t &requests, idx_t &bytes);
+	void UploadFull();
+	unique_ptr<HTTPResponse> SendRange(WebDAVPartialUpdateMode mode, idx_t start, idx_t length, bool guard);
+	bool ServerSupportsPatch();
+	//! Whether a PUT with Content-Range updates a scratch file in place instead of replacing it
+	bool ServerSupportsContentRange();
+	//! Check the status of an upload, returns false if the guard failed only because the ETag turned strong/weak
+	bool CheckUpload(const HTTPResponse &response, const char *what);
+	void UpdateETag(const HTTPResponse &response);
+	void RefreshETag();
+	void MarkDirty(idx_t start, idx_t end);
+
+private:
+	WebDAVFileHandle &handle;
+	unique_ptr<FileSystem> local_fs;
+	unique_ptr<FileHandle> local_file;
+	string local_path;
+
+	//! Held for every operation: reads fetch into and writes modify the same blocks
+	mutex lock;
+	//! Size of the file including local changes
+	idx_t size;
+	//! Remote bytes below this offset are fetched on first access. Bytes above it were written locally or were cut off
+	//! by a truncation, so the remote copy is never read for them.
+	idx_t fetch_limit;
+	//! Size of the file on the server after the last sync
+	idx_t remote_size;
+	bool remote_exists;
+	//! ETag of the server copy after the last sync, empty if unknown
+	string etag;
+	//! Whether the ETag may be stale (the server did not return the new one after a full upload)
+	bool etag_stale = false;
+	//! Set when a partial update returned no ETag: later uploads could not be guarded, so syncs fail
+	bool guard_lost = false;
+
+	//! Blocks below fetch_limit that are in the local copy
+	vector<bool> present;
+	//! Blocks written since the last sync
+	vector<bool> dirty;
+	bool has_dirty = false;
+
+	//! Result of the OPTIONS probe (AUTO mode) or the Content-Range probe, false as well once the server rejected a
+	//! partial update
+	bool partial_update_probed = false;
+	bool partial_update_supported = false;
+};
+
+} // namespace duckdb
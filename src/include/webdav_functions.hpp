@@ -0,0 +1,15 @@
+#pragma once
+
+#include "duckdb.hpp"
+
+namespace duckdb {
+class ExtensionLoader;
+class WebDAVFileSystem;
+
+struct WebDAVFunctions {
+public:
+	//! Register the WebDAV table functions, bound to the registered WebDAV file system
+	static void Register(ExtensionLoader &loader, WebDAVFileSystem &fs);
+};
+
+} // namespace duckdb
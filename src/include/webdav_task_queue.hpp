@@ -0,0 +1,136 @@
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/error_data.hpp"
+#include "duckdb/common/file_opener.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/client_context_state.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <thread>
+
+namespace duckdb {
+
+//! Runs deferred WebDAV work (uploads of closed files) on background threads, one queue per client.
+//! A query does not finish before the tasks it scheduled have completed. The hooks of ClientContextState must not
+//! throw, so failures are recorded and raised by the next WebDAV operation of the client that is allowed to fail:
+//! scheduling another upload or opening a file.
+class WebDAVTaskQueue : public ClientContextState {
+public:
+	explicit WebDAVTaskQueue(idx_t thread_count_p) : thread_count(thread_count_p) {
+	}
+	~WebDAVTaskQueue() override;
+
+	//! Schedule a task operating on the remote resource 'path'
+	void Schedule(const string &path, std::function<void()> task);
+	//! Wait for all pending tasks on resources starting with 'prefix', then raise the first error not raised yet
+	void Wait(const string &prefix);
+	//! Raise the first error not raised yet, without waiting
+	void RaiseErrors();
+	//! Wait for all pending tasks and drop any errors
+	void Drain();
+	//! Drop the tasks that did not start yet and wait for the running ones. Errors are kept.
+	void Cancel();
+	//! Raise the number of background threads (threads are never stopped before the queue is destroyed)
+	void SetThreadCount(idx_t thread_count_p);
+
+	void TransactionCommit(MetaTransaction &transaction, ClientContext &context) override {
+		WaitInternal(string(), false);
+	}
+	//! Uploads of a rolled back transaction that did not start yet are dropped, running ones still complete
+	void TransactionRollback(MetaTransaction &transaction, ClientContext &context) override {
+		Cancel();
+	}
+	void QueryEnd(ClientContext &context) override {
+		WaitInternal(string(), false);
+	}
+
+	//! Get the queue of the client, creating it if it does not exist yet
+	static shared_ptr<WebDAVTaskQueue> GetOrCreate(optional_ptr<FileOpener> opener, idx_t thread_count);
+	//! Get the queue of the client, if one was created
+	static shared_ptr<WebDAVTaskQueue> TryGet(optional_ptr<FileOpener> opener);
+
+private:
+	struct PendingTask {
+		string path;
+		std::function<void()> task;
+	};
+	struct TaskError {
+		string path;
+		ErrorData error;
+		//! Whether a WebDAV operation already raised the error
+		bool raised = false;
+	};
+
+	void WorkerLoop();
+	bool HasPendingLocked(const string &prefix);
+	void WaitInternal(const string &prefix, bool throw_errors);
+	//! Take the first error not raised yet; called with the lock held
+	ErrorData TakeErrorLocked();
+
+private:
+	mutex lock;
+	std::condition_variable task_available;
+	std::condition_variable task_finished;
+	std::deque<PendingTask> tasks;
+	//! Paths of the tasks that are queued or running
+	vector<string> pending_paths;
+	vector<TaskError> errors;
+	vector<std::thread> workers;
+	idx_t thread_count;
+	bool shutdown = false;
+};
+
+//! Reads remote files into the external file cache on background threads while a query runs, so scans of uncached
+//! files find their data already fetched. Prefetching of a glob result starts once one of its files is opened for
+//! reading, and stops when the query or its transaction ends.
+class WebDAVPrefetcher : public ClientContextState {
+public:
+	explicit WebDAVPrefetcher(idx_t thread_count) : queue(make_shared_ptr<WebDAVTaskQueue>(thread_count)) {
+	}
+	~WebDAVPrefetcher() override;
+
+	//! Fetch the uncached files of 'files' whose size is known from the listing. 'cached_bytes' maps paths to the
+	//! number of bytes already held in the external file cache. Files larger than 'max_file_size' are skipped, except
+	//! for the footer of Parquet files, which every scan reads.
+	void Prefetch(ClientContext &context, const vector<OpenFileInfo> &files,
+	              const unordered_map<string, idx_t> &cached_bytes, idx_t max_file_size);
+	//! Remember the result of a glob of the current query
+	void AddGlobResult(vector<OpenFileInfo> files);
+	//! Remove the glob result listing 'path' and return its other files, empty if no glob result lists it
+	vector<OpenFileInfo> TakeGlobResult(const string &path);
+
+	void TransactionCommit(MetaTransaction &transaction, ClientContext &context) override {
+		Cancel();
+	}
+	void TransactionRollback(MetaTransaction &transaction, ClientContext &context) override {
+		Cancel();
+	}
+	void QueryEnd(ClientContext &context) override {
+		Cancel();
+	}
+
+	//! Get the prefetcher of the client, creating it if it does not exist yet
+	static shared_ptr<WebDAVPrefetcher> GetOrCreate(ClientContext &context, idx_t thread_count);
+
+	//! Bytes prefetched from the end of Parquet files too large to be prefetched whole: the footer and, for most
+	//! files, the column metadata
+	static constexpr idx_t FOOTER_PREFETCH_SIZE = 64ULL * 1024;
+
+private:
+	//! Skip the tasks that did not start yet and wait for the running ones
+	void Cancel();
+
+private:
+	std::atomic<bool> cancelled {false};
+	shared_ptr<WebDAVTaskQueue> queue;
+	mutex lock;
+	//! Glob results of the current query none of whose files was opened yet
+	vector<vector<OpenFileInfo>> glob_results;
+};
+
+} // namespace duckdb
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "httpfs.hpp"
+#include "webdav_task_queue.hpp"
+#include "webdav_block_store.hpp"
 #include "duckdb/common/file_opener.hpp"
 #include "duckdb/common/case_insensitive_map.hpp"
 
@@ -21,6 +23,76 @@ struct ParsedWebDAVUrl {
 	string GetHTTPUrl() const;
 };
 
+//! One <response> element of a PROPFIND multistatus reply
+struct WebDAVPropfindEntry {
+	//! URL-decoded path of the resource (scheme and host stripped)
+	string href;
+	bool is_collection = false;
+	bool has_content_length = false;
+	idx_t content_length = 0;
+	string last_modified;
+	string etag;
+	//! getctag of collections (SabreDAV, Nextcloud, ownCloud)
+	string ctag;
+
+	//! The tag that changes when anything below the collection changes, if the server provides one
+	const string &CollectionTag() const {
+		return ctag.empty() ? etag : ctag;
+	}
+};
+
+//! The members of a collection as listed while the collection had 'tag'
+struct WebDAVListing {
+	string tag;
+	vector<WebDAVPropfindEntry> members;
+};
+
+//! Collection listings made during the current query. Glob is called once per pattern, so with this overlapping
+//! patterns of a query list every collection once, and they all see the same snapshot.
+class WebDAVQueryListings : public ClientContextState {
+public:
+	bool TryGet(const string &key, WebDAVListing &result);
+	void Insert(const string &key, const WebDAVListing &listing);
+
+	void QueryEnd(ClientContext &context) override;
+
+	//! Get the listings of the client, nullptr if there is no client context
+	static shared_ptr<WebDAVQueryListings> TryGetOrCreate(optional_ptr<FileOpener> opener);
+
+private:
+	mutex lock;
+	unordered_map<string, WebDAVListing> listings;
+};
+
+//! Measured transfer statistics of a WebDAV host, used to project transfer times
+struct WebDAVHostStats {
+	idx_t requests = 0;
+	idx_t bytes = 0;
+	double seconds = 0;
+};
+
+//! Uploads made by the syncs (checkpoints) of a file served from a block store
+struct WebDAVSyncStats {
+	idx_t syncs = 0;
+	//! Syncs that uploaded the whole file
+	idx_t full_uploads = 0;
+	//! PATCH or ranged PUT requests
+	idx_t partial_updates = 0;
+	idx_t bytes_uploaded = 0;
+};
+
+//! Result of reading a file from an offset to its end
+struct WebDAVTailResponse {
+	//! The file still has the ETag it was requested with (HTTP 304)
+	bool not_modified = false;
+	//! The offset is past the end of the file (HTTP 416)
+	bool range_not_satisfiable = false;
+	//! File offset of the first byte in 'data' (0 when the server ignored the range)
+	idx_t data_start = 0;
+	string data;
+	string etag;
+};
+
 class WebDAVFileHandle : public HTTPFileHandle {
 	friend class WebDAVFileSystem;
 
@@ -30,11 +102,6 @@ public:
 	                 shared_ptr<HTTPUtil> curl_util_p = nullptr)
 	    : HTTPFileHandle(fs, file, flags, std::move(http_params_p)), auth_params(auth_params_p),
 	      curl_util(curl_util_p) {
-		if (flags.OpenForReading() && flags.OpenForWriting()) {
-			throw NotImplementedException("Cannot open a WebDAV file for both reading and writing");
-		} else if (flags.OpenForAppending()) {
-			throw NotImplementedException("Cannot open a WebDAV file for appending");
-		}
 	}
 	~WebDAVFileHandle() override;
 
@@ -50,10 +117,25 @@ public:
 	string temp_file_path;        // Path to temp file if spilled to disk
 	bool using_temp_file = false; // Whether we've spilled to temp file
 
+	// Background uploader of the client; when set, Close() hands the pending upload to it instead of blocking
+	shared_ptr<WebDAVTaskQueue> upload_queue;
+
+	// Local copy serving files opened for reading and writing or for appending (e.g. attached databases)
+	unique_ptr<WebDAVBlockStore> block_store;
+
 public:
 	void Close() override;
 	void Initialize(optional_ptr<FileOpener> opener) override;
 	void FlushBuffer();
+	//! Whether the file is served from a local block store instead of being streamed
+	bool UsesBlockStore() const {
+		return (flags.OpenForReading() && flags.OpenForWriting()) || flags.OpenForAppending();
+	}
+
+private:
+	void InitializeBlockStore(optional_ptr<FileOpener> opener);
+	//! Move the pending write data into a new handle that can be uploaded after this handle is destroyed
+	shared_ptr<WebDAVFileHandle> DetachPendingUpload();
 
 protected:
 	unique_ptr<HTTPClient> CreateClient() override;
@@ -74,6 +156,11 @@ public:
 	duckdb::unique_ptr<HTTPResponse> MkcolRequest(FileHandle &handle, string url, HTTPHeaders header_map);
 	duckdb::unique_ptr<HTTPResponse> MoveRequest(FileHandle &handle, string source_url, string dest_url,
 	                                             HTTPHeaders header_map);
+	//! OPTIONS, used to discover the features advertised in the DAV header
+	duckdb::unique_ptr<HTTPResponse> OptionsRequest(FileHandle &handle, string url, HTTPHeaders header_map);
+	//! PATCH with a partial update body (the caller sets Content-Type and X-Update-Range)
+	duckdb::unique_ptr<HTTPResponse> PatchRequest(FileHandle &handle, string url, HTTPHeaders header_map,
+	                                              char *buffer_in, idx_t buffer_in_len);
 	duckdb::unique_ptr<HTTPResponse> CustomRequest(FileHandle &handle, string url, HTTPHeaders header_map,
 	                                               const string &method, char *buffer_in, idx_t buffer_in_len);
 
@@ -98,6 +185,9 @@ public:
 	void RemoveDirectory(const string &directory, optional_ptr<FileOpener> opener = nullptr) override;
 	void FileSync(FileHandle &handle) override;
 	void Write(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) override;
+	void Read(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) override;
+	int64_t GetFileSize(FileHandle &handle) override;
+	void Truncate(FileHandle &handle, int64_t new_size) override;
 
 	bool OnDiskFile(FileHandle &handle) override {
 		return false;
@@ -106,6 +196,9 @@ public:
 	bool FileExists(const string &filename, optional_ptr<FileOpener> opener = nullptr) override;
 	bool DirectoryExists(const string &directory, optional_ptr<FileOpener> opener = nullptr) override;
 	vector<OpenFileInfo> Glob(const string &glob_pattern, FileOpener *opener = nullptr) override;
+	//! Expand several patterns at once: patterns on the same host are served by one crawl from their common prefix,
+	//! listing each collection once and matching its files against every pattern. Returns one result per pattern.
+	vector<vector<OpenFileInfo>> GlobBatch(const vector<string> &glob_patterns, FileOpener *opener = nullptr);
 
 	unique_ptr<FileHandle> OpenFileExtended(const OpenFileInfo &file, FileOpenFlags flags,
 	                                        optional_ptr<FileOpener> opener) override;
@@ -117,6 +210,29 @@ public:
 	               FileOpener *opener = nullptr) override;
 
 	static ParsedWebDAVUrl ParseUrl(const string &url);
+	//! Parse a PROPFIND multistatus body (namespace prefixes are ignored)
+	static vector<WebDAVPropfindEntry> ParsePropfindResponse(const string &xml_response);
+
+	//! Record a completed download from the host of 'url'
+	void RecordTransfer(const string &url, idx_t bytes, double seconds);
+	//! Get the transfer statistics measured for 'host'
+	bool TryGetHostStats(const string &host, WebDAVHostStats &result);
+	//! Record a sync of a block store: a full upload, or 'partial_updates' ranged writes
+	void RecordSync(const string &url, bool full_upload, idx_t partial_updates, idx_t bytes);
+	//! The sync statistics of every file synced since the extension was loaded, by URL
+	unordered_map<string, WebDAVSyncStats> GetSyncStats();
+	//! Bytes of each file held in DuckDB's external file cache, by path
+	static unordered_map<string, idx_t> GetCachedBytes(ClientContext &context);
+	//! 'path' is opened for reading: prefetch the other files of the glob result it was listed in
+	void StartPrefetch(const string &path, optional_ptr<FileOpener> opener);
+
+	//! Read 'path' from 'offset' to the end with an open-ended range request, without a HEAD request first.
+	//! When 'etag' is set the request is conditional and an unchanged file transfers no data.
+	WebDAVTailResponse ReadTail(const string &path, idx_t offset, const string &etag,
+	                            optional_ptr<FileOpener> opener);
+
+	//! Maximum number of collections kept in the listing cache
+	static constexpr idx_t LISTING_CACHE_CAPACITY = 16384;
 
 protected:
 	duckdb::unique_ptr<HTTPFileHandle> CreateHandle(const OpenFileInfo &file, FileOpenFlags flags,
@@ -130,6 +246,29 @@ private:
 	string DirectPropfindRequest(const string &url, const WebDAVAuthParams &auth_params, int depth);
 	void CreateDirectoryWithHandle(const string &directory, WebDAVFileHandle &handle);
 	void CreateDirectoryRecursiveWithHandle(const string &directory, WebDAVFileHandle &handle);
+
+	//! Create a handle for issuing requests on 'path' without initializing it (no HEAD request)
+	unique_ptr<WebDAVFileHandle> CreateRequestHandle(const string &path, optional_ptr<FileOpener> opener);
+	//! PROPFIND 'url' and parse the response, returns false if the request failed
+	bool ListCollection(WebDAVFileHandle &handle, const string &url, int depth, vector<WebDAVPropfindEntry> &entries);
+	//! Collect the files below 'collection_path', descending into the sub-collections accepted by 'descend'.
+	//! 'tag' is the collection tag reported by the parent listing, empty if unknown.
+	void CrawlCollection(WebDAVFileHandle &handle, const string &base_url, const string &collection_path,
+	                     const string &tag, const std::function<bool(const string &)> &descend,
+	                     optional_ptr<WebDAVQueryListings> query_listings, vector<WebDAVPropfindEntry> &files);
+	bool TryGetCachedListing(const string &key, WebDAVListing &result);
+	//! Remember a glob result for prefetching if webdav_prefetch_threads is set
+	void SchedulePrefetch(const vector<OpenFileInfo> &files, FileOpener *opener);
+	void CacheListing(const string &key, WebDAVListing listing);
+
+	mutex host_stats_lock;
+	unordered_map<string, WebDAVHostStats> host_stats;
+	mutex sync_stats_lock;
+	unordered_map<string, WebDAVSyncStats> sync_stats;
+
+	//! Collection listings by user, host and path (only used when webdav_listing_cache is enabled)
+	mutex listing_cache_lock;
+	unordered_map<string, WebDAVListing> listing_cache;
 };
 
 } // namespace duckdb
@@ -0,0 +1,452 @@
+#include "webdav_block_store.hpp"
+
+#include "webdavfs.hpp"
+#include "duckdb/common/numeric_utils.hpp"
+#include "duckdb/common/string_util.hpp"
+
+#include <cstdlib>
+#include <unistd.h>
+
+namespace duckdb {
+
+static idx_t BlockCount(idx_t bytes) {
+	return (bytes + WebDAVBlockStore::BLOCK_SIZE - 1) / WebDAVBlockStore::BLOCK_SIZE;
+}
+
+// Compare two ETags ignoring the weak marker: Apache hands out a weak ETag for a second after a change and the strong
+// one afterwards, both for the same content
+static bool ETagsEquivalent(const string &a, const string &b) {
+	auto strip = [](const string &tag) { return StringUtil::StartsWith(tag, "W/") ? tag.substr(2) : tag; };
+	return strip(a) == strip(b);
+}
+
+static bool IsUploadSuccess(const HTTPResponse &response) {
+	return response.status == HTTPStatusCode::OK_200 || response.status == HTTPStatusCode::Created_201 ||
+	       response.status == HTTPStatusCode::NoContent_204;
+}
+
+// Statuses with which servers turn down a PATCH or a PUT with Content-Range they do not implement
+static bool IsPartialUpdateRejected(const HTTPResponse &response) {
+	return response.status == HTTPStatusCode::BadRequest_400 ||
+	       response.status == HTTPStatusCode::MethodNotAllowed_405 ||
+	       response.status == HTTPStatusCode::UnsupportedMediaType_415 ||
+	       response.status == HTTPStatusCode::NotImplemented_501;
+}
+
+WebDAVBlockStore::WebDAVBlockStore(WebDAVFileHandle &handle_p, idx_t remote_size_p, bool remote_exists_p,
+                                   const string &etag_p, bool overwrite)
+    : handle(handle_p), local_fs(FileSystem::CreateLocal()), size(overwrite ? 0 : remote_size_p), fetch_limit(size),
+      remote_size(remote_size_p), remote_exists(remote_exists_p), etag(etag_p) {
+	auto &directory = handle.http_params.webdav_block_store_directory;
+	string path_template = (directory.empty() ? string("/tmp") : directory) + "/webdav_blocks_XXXXXX";
+	vector<char> path_buffer(path_template.begin(), path_template.end());
+	path_buffer.push_back('\0');
+	int fd = mkstemp(path_buffer.data());
+	if (fd < 0) {
+		throw IOException("Failed to create block store file in \"%s\" for %s", directory, handle.path);
+	}
+	close(fd);
+	local_path = path_buffer.data();
+
+	local_file = local_fs->OpenFile(local_path, FileFlags::FILE_FLAGS_READ | FileFlags::FILE_FLAGS_WRITE);
+	// Sparse until blocks are fetched: only what is read or written takes up space
+	local_fs->Truncate(*local_file, NumericCast<int64_t>(size));
+	present.resize(BlockCount(fetch_limit), false);
+	dirty.resize(BlockCount(size), false);
+	if (!remote_exists || overwrite) {
+		// A new or replaced file is uploaded by the first sync even if nothing was written
+		has_dirty = true;
+	}
+}
+
+WebDAVBlockStore::~WebDAVBlockStore() {
+	local_file.reset();
+	std::remove(local_path.c_str());
+}
+
+WebDAVPartialUpdateMode WebDAVBlockStore::ParsePartialUpdateMode(const string &mode) {
+	auto lower = StringUtil::Lower(mode);
+	if (lower == "auto") {
+		return WebDAVPartialUpdateMode::AUTO;
+	} else if (lower == "patch") {
+		return WebDAVPartialUpdateMode::PATCH;
+	} else if (lower == "content_range") {
+		return WebDAVPartialUpdateMode::CONTENT_RANGE;
+	} else if (lower == "none") {
+		return WebDAVPartialUpdateMode::NONE;
+	}
+	throw InvalidInputException(
+	    "Unrecognized value \"%s\" for webdav_partial_update, expected one of: auto, patch, content_range, none", mode);
+}
+
+void WebDAVBlockStore::FetchMissing(idx_t start, idx_t end) {
+	end = MinValue(end, fetch_limit);
+	if (start >= end) {
+		return;
+	}
+	idx_t last_block = (end - 1) / BLOCK_SIZE;
+	idx_t block = start / BLOCK_SIZE;
+	while (block <= last_block) {
+		if (present[block]) {
+			block++;
+			continue;
+		}
+		// Fetch each run of missing blocks with one request
+		idx_t run_end = block + 1;
+		while (run_end <= last_block && !present[run_end] && (run_end - block) * BLOCK_SIZE < MAX_TRANSFER_SIZE) {
+			run_end++;
+		}
+		FetchBlocks(block, run_end);
+		block = run_end;
+	}
+}
+
+void WebDAVBlockStore::FetchBlocks(idx_t first_block, idx_t end_block) {
+	auto &fs = handle.file_system.Cast<WebDAVFileSystem>();
+	idx_t offset = first_block * BLOCK_SIZE;
+	idx_t length = MinValue(end_block * BLOCK_SIZE, fetch_limit) - offset;
+
+	auto buffer = make_unsafe_uniq_array_uninitialized<char>(length);
+	auto response = fs.GetRangeRequest(handle, handle.path, {}, offset, buffer.get(), length);
+	if (!response) {
+		throw IOException("Failed to read bytes %llu-%llu of %s", offset, offset + length - 1, handle.path);
+	}
+	if (response->HasRequestError()) {
+		throw IOException("Failed to read bytes %llu-%llu of %s: %s", offset, offset + length - 1, handle.path,
+		                  response->GetRequestError());
+	}
+	if (response->status != HTTPStatusCode::PartialContent_206 && response->status != HTTPStatusCode::OK_200) {
+		throw IOException("Failed to read bytes %llu-%llu of %s: HTTP %d", offset, offset + length - 1, handle.path,
+		                  static_cast<int>(response->status));
+	}
+	// Never mix blocks of two versions of the file
+	if (!etag.empty() && !etag_stale && response->HasHeader("ETag") &&
+	    !ETagsEquivalent(response->GetHeaderValue("ETag"), etag)) {
+		throw IOException("%s was changed on the server after it was opened (ETag %s, now %s). Detach and attach it "
+		                  "again to continue with the new version.",
+		                  handle.path, etag, response->GetHeaderValue("ETag"));
+	}
+
+	local_fs->Write(*local_file, buffer.get(), NumericCast<int64_t>(length), offset);
+	for (idx_t block = first_block; block < end_block; block++) {
+		present[block] = true;
+	}
+}
+
+void WebDAVBlockStore::MarkDirty(idx_t start, idx_t end) {
+	if (start >= end) {
+		return;
+	}
+	// Dirty blocks are uploaded whole: boundary blocks need their remote part locally
+	if (start % BLOCK_SIZE != 0) {
+		FetchMissing(start - 1, start);
+	}
+	if (end % BLOCK_SIZE != 0) {
+		FetchMissing(end, end + 1);
+	}
+	dirty.resize(BlockCount(size), false);
+	for (idx_t block = start / BLOCK_SIZE; block <= (end - 1) / BLOCK_SIZE; block++) {
+		dirty[block] = true;
+	}
+	has_dirty = true;
+}
+
+void WebDAVBlockStore::Read(void *buffer, idx_t nr_bytes, idx_t location) {
+	lock_guard<mutex> guard(lock);
+	if (location + nr_bytes > size) {
+		throw IOException("Could not read %llu bytes at offset %llu from %s: the file is only %llu bytes", nr_bytes,
+		                  location, handle.path, size);
+	}
+	FetchMissing(location, location + nr_bytes);
+	local_fs->Read(*local_file, buffer, NumericCast<int64_t>(nr_bytes), location);
+}
+
+void WebDAVBlockStore::Write(const void *buffer, idx_t nr_bytes, idx_t location) {
+	lock_guard<mutex> guard(lock);
+	if (nr_bytes == 0) {
+		return;
+	}
+	idx_t end = location + nr_bytes;
+	// Blocks that are only partly overwritten keep the rest of their remote content
+	if (location % BLOCK_SIZE != 0) {
+		FetchMissing(location, location + 1);
+	}
+	if (end % BLOCK_SIZE != 0) {
+		FetchMissing(end - 1, end);
+	}
+	local_fs->Write(*local_file, const_cast<void *>(buffer), NumericCast<int64_t>(nr_bytes), location);
+	// Blocks in between are replaced entirely and never need to be fetched
+	for (idx_t block = location / BLOCK_SIZE; block < present.size() && block <= (end - 1) / BLOCK_SIZE; block++) {
+		present[block] = true;
+	}
+	auto old_size = size;
+	size = MaxValue(size, end);
+	// Writing past the end fills the gap with zeros, which the server has to receive as well (as in Truncate)
+	MarkDirty(MinValue(old_size, location), end);
+}
+
+void WebDAVBlockStore::Truncate(idx_t new_size) {
+	lock_guard<mutex> guard(lock);
+	if (new_size < fetch_limit) {
+		// Keep the part of the boundary block below the new end
+		if (new_size % BLOCK_SIZE != 0) {
+			FetchMissing(new_size - 1, new_size);
+		}
+		fetch_limit = new_size;
+		present.resize(BlockCount(fetch_limit));
+	}
+	local_fs->Truncate(*local_file, NumericCast<int64_t>(new_size));
+	auto old_size = size;
+	size = new_size;
+	dirty.resize(BlockCount(size), false);
+	if (new_size > old_size) {
+		// Extending fills with zeros, which the server has to receive as well
+		MarkDirty(old_size, new_size);
+	} else if (new_size < remote_size) {
+		// Only a full upload shrinks the remote file: partial updates send nothing for this and keep the remote bytes
+		// past the end
+		has_dirty = true;
+	}
+}
+
+bool WebDAVBlockStore::HasUnsyncedChanges() {
+	lock_guard<mutex> guard(lock);
+	return has_dirty || size > remote_size;
+}
+
+idx_t WebDAVBlockStore::GetSize() {
+	lock_guard<mutex> guard(lock);
+	return size;
+}
+
+void WebDAVBlockStore::Sync() {
+	lock_guard<mutex> guard(lock);
+	if (guard_lost) {
+		throw IOException("Failed to update %s: the ETag of the file on the server is unknown since a partial update. "
+		                  "Detach and attach the database again.",
+		                  handle.path);
+	}
+	// Partial updates leave the remote file longer than 'size' (see below), which needs no further sync
+	if (!has_dirty && size <= remote_size) {
+		return;
+	}
+
+	auto configured_mode = ParsePartialUpdateMode(handle.http_params.webdav_partial_update);
+	auto mode = configured_mode;
+	if (!remote_exists) {
+		// Partial updates cannot create a file
+		mode = WebDAVPartialUpdateMode::NONE;
+	} else if (mode == WebDAVPartialUpdateMode::AUTO) {
+		mode = ServerSupportsPatch() ? WebDAVPartialUpdateMode::PATCH : WebDAVPartialUpdateMode::NONE;
+	}
+
+	// 'auto' never picks Content-Range: it is only used when configured, and after a probe showed that it works
+	idx_t partial_updates = 0;
+	idx_t bytes_uploaded = 0;
+	if (mode != WebDAVPartialUpdateMode::NONE &&
+	    ((mode == WebDAVPartialUpdateMode::CONTENT_RANGE && !ServerSupportsContentRange()) ||
+	     !UploadRanges(mode, partial_updates, bytes_uploaded))) {
+		// Only a detected method falls back to a full upload; an explicitly configured one must work
+		if (configured_mode != WebDAVPartialUpdateMode::AUTO) {
+			throw IOException("Failed to update %s: the server does not accept partial updates with %s. Use "
+			                  "webdav_partial_update = 'auto' or 'none' to upload the whole file instead.",
+			                  handle.path,
+			                  mode == WebDAVPartialUpdateMode::PATCH ? "PATCH" : "PUT with Content-Range");
+		}
+		mode = WebDAVPartialUpdateMode::NONE;
+	}
+	if (mode == WebDAVPartialUpdateMode::NONE) {
+		UploadFull();
+		bytes_uploaded += size;
+	}
+	handle.file_system.Cast<WebDAVFileSystem>().RecordSync(handle.path, mode == WebDAVPartialUpdateMode::NONE,
+	                                                       partial_updates, bytes_uploaded);
+	if (etag_stale) {
+		RefreshETag();
+	}
+
+	std::fill(dirty.begin(), dirty.end(), false);
+	has_dirty = false;
+	// Partial updates cannot shrink the remote file. DuckDB reads the block count from the database header, so the
+	// stale bytes past the end are never used, and the next full upload drops them.
+	remote_size = mode == WebDAVPartialUpdateMode::NONE ? size : MaxValue(remote_size, size);
+	remote_exists = true;
+}
+
+bool WebDAVBlockStore::ServerSupportsPatch() {
+	if (partial_update_probed) {
+		return partial_update_supported;
+	}
+	auto &fs = handle.file_system.Cast<WebDAVFileSystem>();
+	auto response = fs.OptionsRequest(handle, handle.path, {});
+	partial_update_probed = true;
+	partial_update_supported = response && response->HasHeader("DAV") &&
+	                           StringUtil::Contains(response->GetHeaderValue("DAV"), "sabredav-partialupdate");
+	return partial_update_supported;
+}
+
+bool WebDAVBlockStore::ServerSupportsContentRange() {
+	if (partial_update_probed) {
+		return partial_update_supported;
+	}
+	// Servers that ignore Content-Range (nginx, Apache mod_dav) replace the file with the fragment and still answer
+	// 2xx, which would destroy the file. Try it on a scratch file next to it instead.
+	auto &fs = handle.file_system.Cast<WebDAVFileSystem>();
+	auto probe_url = handle.path + ".content-range-probe";
+	char initial[] = {'a', 'b'};
+	char fragment[] = {'c'};
+	bool supported = false;
+	auto put = fs.PutRequest(handle, probe_url, {}, initial, sizeof(initial));
+	if (put && IsUploadSuccess(*put)) {
+		HTTPHeaders headers;
+		headers.Insert("Content-Range", "bytes 1-1/2");
+		auto update = fs.PutRequest(handle, probe_url, headers, fragment, sizeof(fragment));
+		if (update && IsUploadSuccess(*update)) {
+			auto head = fs.HeadRequest(handle, probe_url, {});
+			if (head && head->status == HTTPStatusCode::OK_200 && head->HasHeader("Content-Length") &&
+			    head->GetHeaderValue("Content-Length") == "2") {
+				char content[2];
+				auto get = fs.GetRangeRequest(handle, probe_url, {}, 0, content, sizeof(content));
+				supported = get &&
+				            (get->status == HTTPStatusCode::PartialContent_206 ||
+				             get->status == HTTPStatusCode::OK_200) &&
+				            content[0] == 'a' && content[1] == 'c';
+			}
+		}
+		fs.DeleteRequest(handle, probe_url, {});
+	}
+	partial_update_probed = true;
+	partial_update_supported = supported;
+	return supported;
+}
+
+unique_ptr<HTTPResponse> WebDAVBlockStore::SendRange(WebDAVPartialUpdateMode mode, idx_t start, idx_t length,
+                                                     bool guard) {
+	auto &fs = handle.file_system.Cast<WebDAVFileSystem>();
+	auto buffer = make_unsafe_uniq_array_uninitialized<char>(length);
+	local_fs->Read(*local_file, buffer.get(), NumericCast<int64_t>(length), start);
+
+	HTTPHeaders headers;
+	if (guard && !etag.empty() && !etag_stale) {
+		headers.Insert("If-Match", etag);
+	}
+	string range = to_string(start) + "-" + to_string(start + length - 1);
+	if (mode == WebDAVPartialUpdateMode::PATCH) {
+		headers.Insert("Content-Type", "application/x-sabredav-partialupdate");
+		headers.Insert("X-Update-Range", "bytes=" + range);
+		return fs.PatchRequest(handle, handle.path, headers, buffer.get(), length);
+	}
+	headers.Insert("Content-Range", "bytes " + range + "/" + to_string(MaxValue(size, remote_size)));
+	return fs.PutRequest(handle, handle.path, headers, buffer.get(), length);
+}
+
+bool WebDAVBlockStore::UploadRanges(WebDAVPartialUpdateMode mode, idx_t &requests, idx_t &bytes) {
+	bool first_request = true;
+	idx_t block_count = dirty.size();
+	idx_t block = 0;
+	while (block < block_count) {
+		if (!dirty[block]) {
+			block++;
+			continue;
+		}
+		idx_t run_end = block + 1;
+		while (run_end < block_count && dirty[run_end] && (run_end - block) * BLOCK_SIZE < MAX_TRANSFER_SIZE) {
+			run_end++;
+		}
+		idx_t start = block * BLOCK_SIZE;
+		idx_t length = MinValue(run_end * BLOCK_SIZE, size) - start;
+
+		auto response = SendRange(mode, start, length, true);
+		if (first_request && IsPartialUpdateRejected(*response)) {
+			// Remembered for AUTO, which then uploads whole files from now on
+			partial_update_probed = true;
+			partial_update_supported = false;
+			return false;
+		}
+		if (!CheckUpload(*response, "update")) {
+			response = SendRange(mode, start, length, false);
+			CheckUpload(*response, "update");
+		}
+		if (!response->HasHeader("ETag")) {
+			// A HEAD could return the ETag of another writer's version, so the next request cannot be guarded
+			guard_lost = true;
+			throw IOException("Failed to update %s: the server returned no ETag for a partial update, so further "
+			                  "changes cannot be guarded against other writers. Detach and attach the database "
+			                  "again, with webdav_partial_update = 'none' for this server.",
+			                  handle.path);
+		}
+		UpdateETag(*response);
+		requests++;
+		bytes += length;
+		first_request = false;
+		block = run_end;
+	}
+	partial_update_probed = true;
+	partial_update_supported = true;
+	return true;
+}
+
+void WebDAVBlockStore::UploadFull() {
+	auto &fs = handle.file_system.Cast<WebDAVFileSystem>();
+	// Every byte goes up, so everything not read so far has to come down first
+	FetchMissing(0, size);
+
+	auto put = [&](bool guard) {
+		HTTPHeaders headers;
+		if (guard && !remote_exists) {
+			// Do not replace a file that someone else created in the meantime
+			headers.Insert("If-None-Match", "*");
+		} else if (guard && !etag.empty() && !etag_stale) {
+			headers.Insert("If-Match", etag);
+		}
+		return fs.PutRequestFromFile(handle, handle.path, headers, local_path, size);
+	};
+	auto response = put(true);
+	if (!CheckUpload(*response, "upload")) {
+		response = put(false);
+		CheckUpload(*response, "upload");
+	}
+	UpdateETag(*response);
+}
+
+bool WebDAVBlockStore::CheckUpload(const HTTPResponse &response, const char *what) {
+	if (IsUploadSuccess(response)) {
+		return true;
+	}
+	if (response.status == HTTPStatusCode::PreconditionFailed_412) {
+		// A weak ETag never matches If-Match: retry unguarded if the file is in fact unchanged
+		if (remote_exists && !etag.empty()) {
+			auto &fs = handle.file_system.Cast<WebDAVFileSystem>();
+			auto head = fs.HeadRequest(handle, handle.path, {});
+			if (head->status == HTTPStatusCode::OK_200 && head->HasHeader("ETag") &&
+			    ETagsEquivalent(head->GetHeaderValue("ETag"), etag)) {
+				return false;
+			}
+		}
+		throw IOException("Failed to %s %s: the file was changed on the server after it was opened (ETag %s). "
+		                  "Detach and attach it again to continue with the new version.",
+		                  what, handle.path, etag.empty() ? string("unknown") : etag);
+	}
+	throw IOException("Failed to %s %s: HTTP %d", what, handle.path, static_cast<int>(response.status));
+}
+
+void WebDAVBlockStore::UpdateETag(const HTTPResponse &response) {
+	if (response.HasHeader("ETag")) {
+		etag = response.GetHeaderValue("ETag");
+		etag_stale = false;
+	} else {
+		// Only reached for full uploads, which are single requests: ask for the new ETag when done
+		etag_stale = true;
+	}
+}
+
+void WebDAVBlockStore::RefreshETag() {
+	auto &fs = handle.file_system.Cast<WebDAVFileSystem>();
+	auto response = fs.HeadRequest(handle, handle.path, {});
+	etag = response->status == HTTPStatusCode::OK_200 && response->HasHeader("ETag")
+	           ? response->GetHeaderValue("ETag")
+	           : string();
+	etag_stale = false;
+}
+
+} // namespace duckdb
@@ -3,7 +3,9 @@
 #include "webdavfs_extension.hpp"
 #include "webdavfs.hpp"
 #include "webdav_secrets.hpp"
+#include "webdav_functions.hpp"
 #include "httpfs_client.hpp"
+#include "crypto.hpp"
 #include "duckdb.hpp"
 #include "duckdb/common/exception.hpp"
 #include "duckdb/main/database_manager.hpp"
@@ -12,6 +14,10 @@
 
 namespace duckdb {
 
+static void ValidatePartialUpdateMode(ClientContext &context, SetScope scope, Value &parameter) {
+	WebDAVBlockStore::ParsePartialUpdateMode(parameter.ToString());
+}
+
 static void LoadInternal(ExtensionLoader &loader) {
 	// Register WebDAV file system
 	auto &instance = loader.GetDatabaseInstance();
@@ -29,6 +35,34 @@ static void LoadInternal(ExtensionLoader &loader) {
 	    "File size threshold in MB for streaming uploads (files larger than this are streamed from disk)",
 	    LogicalType::BIGINT, Value::BIGINT(50));
 
+	config.AddExtensionOption("webdav_upload_threads",
+	                          "Number of background threads uploading closed files (0 uploads synchronously on close)",
+	                          LogicalType::BIGINT, Value::BIGINT(2));
+
+	config.AddExtensionOption("webdav_listing_cache",
+	                          "Cache collection listings and skip re-listing collections whose ETag/ctag did not change "
+	                          "(only safe on servers that update collection tags on nested changes)",
+	                          LogicalType::BOOLEAN, Value(false));
+
+	config.AddExtensionOption("webdav_prefetch_threads",
+	                          "Number of background threads prefetching uncached globbed files into the external file "
+	                          "cache while a query runs (0 disables prefetching)",
+	                          LogicalType::BIGINT, Value::BIGINT(0));
+
+	config.AddExtensionOption("webdav_prefetch_max_file_size_mb",
+	                          "Largest file in MB that is prefetched whole; of larger Parquet files only the footer is "
+	                          "prefetched",
+	                          LogicalType::BIGINT, Value::BIGINT(4));
+
+	config.AddExtensionOption("webdav_partial_update",
+	                          "How checkpoints of files opened for reading and writing upload changed blocks: 'auto' "
+	                          "(PATCH if the server advertises it), 'patch', 'content_range' or 'none' (whole file)",
+	                          LogicalType::VARCHAR, Value("auto"), ValidatePartialUpdateMode);
+
+	config.AddExtensionOption("webdav_block_store_directory",
+	                          "Directory for the local copies of files opened for reading and writing (default: /tmp)",
+	                          LogicalType::VARCHAR, Value(""));
+
 	// Set up HTTP utility (CURL-based)
 	// Always use HTTPFSCurlUtil for WebDAV since we need custom HTTP methods
 	// Note: HTTPFSCurlUtil::GetName() returns "HTTPFS-Curl", not "HTTPFSCurlUtil"
@@ -39,11 +73,19 @@ static void LoadInternal(ExtensionLoader &loader) {
 		config.http_util = make_shared_ptr<HTTPFSCurlUtil>();
 	}
 
+	// Use OpenSSL (with pooled cipher contexts) for encrypted databases
+	config.encryption_util = make_shared_ptr<AESStateSSLFactory>();
+
 	auto &fs = instance.GetFileSystem();
-	fs.RegisterSubSystem(make_uniq<WebDAVFileSystem>());
+	auto webdav_fs = make_uniq<WebDAVFileSystem>();
+	auto &webdav_fs_ref = *webdav_fs;
+	fs.RegisterSubSystem(std::move(webdav_fs));
 
 	// Register WebDAV secrets
 	CreateWebDAVSecretFunctions::Register(loader);
+
+	// Register WebDAV table functions
+	WebDAVFunctions::Register(loader, webdav_fs_ref);
 }
 
 void WebdavfsExtension::Load(ExtensionLoader &loader) {
@@ -0,0 +1,681 @@
+#include "webdav_functions.hpp"
+
+#include "webdavfs.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/client_context_state.hpp"
+#include "duckdb/main/client_data.hpp"
+#include "duckdb/main/extension/extension_loader.hpp"
+
+#include <algorithm>
+
+namespace duckdb {
+
+//! How far webdav_tail has consumed a file
+struct WebDAVTailCursor {
+	//! End of the last complete record that was returned
+	idx_t offset = 0;
+	string etag;
+	//! The bytes just before 'offset', compared on the next read to detect a rewritten file
+	string tail_bytes;
+};
+
+//! A cursor advanced by webdav_tail that is not committed yet
+struct WebDAVTailUpdate {
+	string path;
+	//! The committed cursor the fetch started from
+	WebDAVTailCursor base;
+	WebDAVTailCursor cursor;
+};
+
+//! Serializes the webdav_tail fetches of one path, removed when no fetch uses it anymore
+struct WebDAVTailFetchLock {
+	mutex lock;
+	idx_t users = 0;
+};
+
+struct WebDAVFunctionInfo : public TableFunctionInfo {
+	explicit WebDAVFunctionInfo(WebDAVFileSystem &fs_p) : fs(fs_p) {
+	}
+
+	WebDAVFileSystem &fs;
+
+	mutex tail_lock;
+	//! Committed positions of webdav_tail
+	unordered_map<string, WebDAVTailCursor> tail_cursors;
+	//! The fetch locks of the paths that are being fetched
+	unordered_map<string, unique_ptr<WebDAVTailFetchLock>> tail_fetch_locks;
+};
+
+//! Holds the fetch lock of a path for the duration of one webdav_tail fetch
+class WebDAVTailFetchGuard {
+public:
+	WebDAVTailFetchGuard(WebDAVFunctionInfo &info_p, const string &path_p) : info(info_p), path(path_p) {
+		{
+			lock_guard<mutex> guard(info.tail_lock);
+			auto &entry = info.tail_fetch_locks[path];
+			if (!entry) {
+				entry = make_uniq<WebDAVTailFetchLock>();
+			}
+			entry->users++;
+			fetch_lock = entry.get();
+		}
+		fetch_lock->lock.lock();
+	}
+	~WebDAVTailFetchGuard() {
+		fetch_lock->lock.unlock();
+		lock_guard<mutex> guard(info.tail_lock);
+		if (--fetch_lock->users == 0) {
+			info.tail_fetch_locks.erase(path);
+		}
+	}
+
+private:
+	WebDAVFunctionInfo &info;
+	string path;
+	optional_ptr<WebDAVTailFetchLock> fetch_lock;
+};
+
+//! The cursors advanced by the webdav_tail calls of the current transaction. They are applied when the transaction
+//! commits, so the lines returned by a query that failed or was rolled back are returned again by the next call.
+//! webdav_tail is single-consumer: connections that read the same file concurrently may both return the same lines,
+//! and only the cursor of the first one to commit is kept.
+class WebDAVTailTransaction : public ClientContextState {
+public:
+	explicit WebDAVTailTransaction(WebDAVFunctionInfo &info_p) : info(info_p) {
+	}
+
+	//! The staged update of 'path', if this transaction read the file already
+	optional_ptr<WebDAVTailUpdate> GetUpdate(const string &path) {
+		lock_guard<mutex> guard(lock);
+		auto entry = updates.find(path);
+		return entry == updates.end() ? nullptr : &entry->second;
+	}
+
+	void Stage(WebDAVTailUpdate update) {
+		lock_guard<mutex> guard(lock);
+		auto entry = updates.find(update.path);
+		if (entry != updates.end()) {
+			// keep the committed cursor of the first read in this transaction
+			entry->second.cursor = std::move(update.cursor);
+			return;
+		}
+		auto path = update.path;
+		updates.emplace(std::move(path), std::move(update));
+	}
+
+	void TransactionCommit(MetaTransaction &transaction, ClientContext &context) override {
+		lock_guard<mutex> guard(lock);
+		lock_guard<mutex> info_guard(info.tail_lock);
+		for (auto &entry : updates) {
+			auto &update = entry.second;
+			auto committed = info.tail_cursors.find(update.path);
+			if (committed == info.tail_cursors.end()) {
+				if (update.base.offset == 0 && update.base.etag.empty()) {
+					info.tail_cursors.emplace(update.path, std::move(update.cursor));
+				}
+				continue;
+			}
+			// Another transaction consumed the file in the meantime: keep its position
+			if (committed->second.offset != update.base.offset || committed->second.etag != update.base.etag) {
+				continue;
+			}
+			committed->second = std::move(update.cursor);
+		}
+		updates.clear();
+	}
+	void TransactionRollback(MetaTransaction &transaction, ClientContext &context) override {
+		lock_guard<mutex> guard(lock);
+		updates.clear();
+	}
+
+	static WebDAVTailTransaction &Get(ClientContext &context, WebDAVFunctionInfo &info) {
+		return *context.registered_state->GetOrCreate<WebDAVTailTransaction>("webdav_tail_transaction", info);
+	}
+
+private:
+	WebDAVFunctionInfo &info;
+	mutex lock;
+	unordered_map<string, WebDAVTailUpdate> updates;
+};
+
+//! Read the path argument of a function: a single pattern or a list of patterns, like read_parquet accepts
+static vector<string> GetPatternsArgument(const Value &input, const string &function_name) {
+	if (input.IsNull()) {
+		throw BinderException("%s: the path pattern cannot be NULL", function_name);
+	}
+	vector<string> patterns;
+	if (input.type().id() == LogicalTypeId::LIST) {
+		for (auto &child : ListValue::GetChildren(input)) {
+			if (child.IsNull()) {
+				throw BinderException("%s: the path pattern cannot be NULL", function_name);
+			}
+			patterns.push_back(StringValue::Get(child));
+		}
+	} else {
+		patterns.push_back(StringValue::Get(input));
+	}
+	for (auto &pattern : patterns) {
+		if (!WebDAVFileSystem::IsWebDAVUrl(pattern)) {
+			throw BinderException("%s: '%s' is not a WebDAV URL", function_name, pattern);
+		}
+	}
+	return patterns;
+}
+
+//! A file matching the patterns of a function call
+struct WebDAVMatchedFile {
+	string path;
+	idx_t file_size;
+	//! Bytes of the file held in the external file cache
+	idx_t cached_bytes;
+	//! Whether the listing or the HTTP metadata cache provide the metadata of the file, so opening it needs no HEAD
+	//! request
+	bool metadata_known;
+};
+
+static vector<WebDAVMatchedFile> GetMatchedFiles(ClientContext &context, WebDAVFileSystem &fs,
+                                                 const vector<string> &patterns) {
+	auto opener = ClientData::Get(context).file_opener.get();
+	auto cached = WebDAVFileSystem::GetCachedBytes(context);
+	auto metadata_cache = fs.TryGetMetadataCache(opener);
+
+	vector<WebDAVMatchedFile> result;
+	for (auto &pattern_files : fs.GlobBatch(patterns, opener)) {
+		for (auto &file : pattern_files) {
+			auto http_url = WebDAVFileSystem::ParseUrl(file.path).GetHTTPUrl();
+
+			// The listing carries the size; fall back to opening the file (a HEAD request) when it does not
+			idx_t file_size = 0;
+			bool has_size = false;
+			if (file.extended_info) {
+				auto entry = file.extended_info->options.find("file_size");
+				if (entry != file.extended_info->options.end()) {
+					file_size = entry->second.GetValue<uint64_t>();
+					has_size = true;
+				}
+			}
+			bool metadata_known = false;
+			if (file.extended_info) {
+				auto &options = file.extended_info->options;
+				metadata_known = has_size && options.find("last_modified") != options.end() &&
+				                 options.find("etag") != options.end();
+			}
+			HTTPMetadataCacheEntry metadata;
+			if (metadata_cache && metadata_cache->Find(http_url, metadata)) {
+				metadata_known = true;
+				if (!has_size) {
+					file_size = metadata.length;
+					has_size = true;
+				}
+			}
+			if (!has_size) {
+				auto handle = fs.OpenFile(file.path, FileFlags::FILE_FLAGS_READ, opener);
+				file_size = fs.GetFileSize(*handle);
+			}
+
+			auto cached_entry = cached.find(file.path);
+			idx_t cached_bytes = cached_entry == cached.end() ? 0 : MinValue<idx_t>(cached_entry->second, file_size);
+			result.push_back({file.path, file_size, cached_bytes, metadata_known});
+		}
+	}
+	return result;
+}
+
+//===--------------------------------------------------------------------===//
+// webdav_scan_estimate
+//===--------------------------------------------------------------------===//
+struct WebDAVScanEstimateBindData : public TableFunctionData {
+	WebDAVScanEstimateBindData(WebDAVFileSystem &fs_p, vector<string> patterns_p)
+	    : fs(fs_p), patterns(std::move(patterns_p)) {
+	}
+
+	WebDAVFileSystem &fs;
+	vector<string> patterns;
+};
+
+struct WebDAVScanEstimateState : public GlobalTableFunctionState {
+	bool finished = false;
+};
+
+struct WebDAVScanEstimate {
+	idx_t file_count = 0;
+	idx_t total_bytes = 0;
+	idx_t cached_bytes = 0;
+	idx_t expected_requests = 0;
+	//! Bytes that still have to be transferred, per host
+	unordered_map<string, idx_t> uncached_bytes_per_host;
+};
+
+static unique_ptr<FunctionData> WebDAVScanEstimateBind(ClientContext &context, TableFunctionBindInput &input,
+                                                       vector<LogicalType> &return_types, vector<string> &names) {
+	auto patterns = GetPatternsArgument(input.inputs[0], "webdav_scan_estimate");
+
+	names = {"file_count",      "total_bytes",     "cached_bytes",     "uncached_bytes",
+	         "expected_requests", "throughput_mb_s", "projected_seconds"};
+	return_types = {LogicalType::BIGINT, LogicalType::UBIGINT, LogicalType::UBIGINT, LogicalType::UBIGINT,
+	                LogicalType::UBIGINT, LogicalType::DOUBLE,  LogicalType::DOUBLE};
+
+	auto &info = input.info->Cast<WebDAVFunctionInfo>();
+	return make_uniq<WebDAVScanEstimateBindData>(info.fs, std::move(patterns));
+}
+
+static unique_ptr<GlobalTableFunctionState> WebDAVScanEstimateInit(ClientContext &context,
+                                                                   TableFunctionInitInput &input) {
+	return make_uniq<WebDAVScanEstimateState>();
+}
+
+static WebDAVScanEstimate ComputeScanEstimate(ClientContext &context, WebDAVFileSystem &fs,
+                                              const vector<string> &patterns) {
+	WebDAVScanEstimate estimate;
+	for (auto &file : GetMatchedFiles(context, fs, patterns)) {
+		idx_t uncached_bytes = file.file_size - file.cached_bytes;
+
+		estimate.file_count++;
+		estimate.total_bytes += file.file_size;
+		estimate.cached_bytes += file.cached_bytes;
+		// One HEAD per file unless its metadata is known, then reads of at most READ_BUFFER_LEN each
+		estimate.expected_requests += file.metadata_known ? 0 : 1;
+		estimate.expected_requests +=
+		    (uncached_bytes + HTTPFileHandle::READ_BUFFER_LEN - 1) / HTTPFileHandle::READ_BUFFER_LEN;
+		estimate.uncached_bytes_per_host[WebDAVFileSystem::ParseUrl(file.path).host] += uncached_bytes;
+	}
+	return estimate;
+}
+
+static void WebDAVScanEstimateFunction(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &state = data_p.global_state->Cast<WebDAVScanEstimateState>();
+	if (state.finished) {
+		return;
+	}
+	state.finished = true;
+
+	auto &bind_data = data_p.bind_data->Cast<WebDAVScanEstimateBindData>();
+	auto estimate = ComputeScanEstimate(context, bind_data.fs, bind_data.patterns);
+
+	// Project the transfer time from the throughput measured for each host; unknown if any host was never measured
+	idx_t uncached_bytes = 0;
+	double projected_seconds = 0;
+	idx_t measured_bytes = 0;
+	double measured_seconds = 0;
+	bool all_measured = true;
+	for (auto &entry : estimate.uncached_bytes_per_host) {
+		uncached_bytes += entry.second;
+		WebDAVHostStats stats;
+		if (!bind_data.fs.TryGetHostStats(entry.first, stats) || stats.seconds <= 0) {
+			all_measured = false;
+			continue;
+		}
+		measured_bytes += stats.bytes;
+		measured_seconds += stats.seconds;
+		projected_seconds += static_cast<double>(entry.second) * stats.seconds / static_cast<double>(stats.bytes);
+	}
+
+	output.SetValue(0, 0, Value::BIGINT(NumericCast<int64_t>(estimate.file_count)));
+	output.SetValue(1, 0, Value::UBIGINT(estimate.total_bytes));
+	output.SetValue(2, 0, Value::UBIGINT(estimate.cached_bytes));
+	output.SetValue(3, 0, Value::UBIGINT(uncached_bytes));
+	output.SetValue(4, 0, Value::UBIGINT(estimate.expected_requests));
+	if (measured_seconds > 0) {
+		output.SetValue(5, 0, Value::DOUBLE(static_cast<double>(measured_bytes) / measured_seconds / (1024 * 1024)));
+	} else {
+		output.SetValue(5, 0, Value(LogicalType::DOUBLE));
+	}
+	if (all_measured) {
+		output.SetValue(6, 0, Value::DOUBLE(projected_seconds));
+	} else {
+		output.SetValue(6, 0, Value(LogicalType::DOUBLE));
+	}
+	output.SetCardinality(1);
+}
+
+//===--------------------------------------------------------------------===//
+// webdav_tail
+//===--------------------------------------------------------------------===//
+//! Number of bytes before the consumed offset that are re-read to verify the file was only appended to
+static constexpr idx_t TAIL_VERIFY_BYTES = 64;
+
+struct WebDAVTailBindData : public TableFunctionData {
+	WebDAVTailBindData(WebDAVFunctionInfo &info_p, string pattern_p)
+	    : info(info_p), pattern(std::move(pattern_p)) {
+	}
+
+	WebDAVFunctionInfo &info;
+	string pattern;
+	bool header = false;
+	bool reset = false;
+};
+
+struct WebDAVTailRecord {
+	idx_t file_idx;
+	idx_t offset;
+	idx_t length;
+};
+
+struct WebDAVTailState : public GlobalTableFunctionState {
+	bool fetched = false;
+	vector<string> files;
+	//! New data of each file and the file offset it starts at
+	vector<string> data;
+	vector<idx_t> data_start;
+	vector<WebDAVTailRecord> records;
+	idx_t record_idx = 0;
+	//! Cursor updates, staged in the transaction once every record was consumed
+	vector<WebDAVTailUpdate> updates;
+	bool staged = false;
+};
+
+static unique_ptr<FunctionData> WebDAVTailBind(ClientContext &context, TableFunctionBindInput &input,
+                                               vector<LogicalType> &return_types, vector<string> &names) {
+	if (input.inputs[0].IsNull()) {
+		throw BinderException("webdav_tail: the path cannot be NULL");
+	}
+	auto pattern = StringValue::Get(input.inputs[0]);
+	if (!WebDAVFileSystem::IsWebDAVUrl(pattern)) {
+		throw BinderException("webdav_tail: '%s' is not a WebDAV URL", pattern);
+	}
+
+	auto &info = input.info->Cast<WebDAVFunctionInfo>();
+	auto result = make_uniq<WebDAVTailBindData>(info, pattern);
+	for (auto &kv : input.named_parameters) {
+		if (kv.second.IsNull()) {
+			throw BinderException("webdav_tail: '%s' cannot be NULL", kv.first);
+		}
+		if (kv.first == "header") {
+			result->header = BooleanValue::Get(kv.second);
+		} else if (kv.first == "reset") {
+			result->reset = BooleanValue::Get(kv.second);
+		}
+	}
+
+	names = {"filename", "line_offset", "line"};
+	return_types = {LogicalType::VARCHAR, LogicalType::UBIGINT, LogicalType::VARCHAR};
+	return std::move(result);
+}
+
+static unique_ptr<GlobalTableFunctionState> WebDAVTailInit(ClientContext &context, TableFunctionInitInput &input) {
+	return make_uniq<WebDAVTailState>();
+}
+
+//! Whether 'response' continues the data described by 'cursor', i.e. the file was only appended to
+static bool IsContinuation(const WebDAVTailCursor &cursor, const WebDAVTailResponse &response) {
+	auto verify_start = cursor.offset - cursor.tail_bytes.size();
+	if (response.data_start > verify_start || response.data_start + response.data.size() < cursor.offset) {
+		return false;
+	}
+	return response.data.compare(verify_start - response.data_start, cursor.tail_bytes.size(), cursor.tail_bytes) ==
+	       0;
+}
+
+//! Fetch the data of 'path' that was not consumed yet, and record the cursor after its last complete line
+static void FetchTail(ClientContext &context, WebDAVTailBindData &bind_data, const string &path,
+                      WebDAVTailState &state) {
+	auto &info = bind_data.info;
+	auto opener = ClientData::Get(context).file_opener.get();
+	WebDAVTailFetchGuard fetch_guard(info, path);
+
+	// Continue after the lines this transaction read already, or else from the committed position
+	WebDAVTailUpdate update;
+	update.path = path;
+	auto staged = WebDAVTailTransaction::Get(context, info).GetUpdate(path);
+	if (staged) {
+		update.base = staged->base;
+	} else {
+		lock_guard<mutex> guard(info.tail_lock);
+		auto entry = info.tail_cursors.find(path);
+		if (entry != info.tail_cursors.end()) {
+			update.base = entry->second;
+		}
+	}
+	WebDAVTailCursor cursor;
+	if (!bind_data.reset) {
+		cursor = staged ? staged->cursor : update.base;
+	}
+
+	// Re-read a few bytes before the offset to detect rewrites that kept (or grew past) the previous size
+	auto request_offset = cursor.offset - cursor.tail_bytes.size();
+	auto response = info.fs.ReadTail(path, request_offset, cursor.etag, opener);
+	if (response.not_modified) {
+		return;
+	}
+	idx_t consume_from = cursor.offset;
+	if (response.range_not_satisfiable || !IsContinuation(cursor, response)) {
+		if (response.range_not_satisfiable && cursor.offset == 0) {
+			// an empty file
+			return;
+		}
+		// Truncated or rewritten: start over from the beginning of the file
+		if (response.data_start != 0 || response.range_not_satisfiable) {
+			response = info.fs.ReadTail(path, 0, string(), opener);
+		}
+		consume_from = 0;
+	}
+
+	// Only complete lines are returned, a partially written last line is picked up by the next call
+	auto &data = response.data;
+	auto data_offset = consume_from - response.data_start;
+	auto last_newline = data.rfind('\n');
+	if (last_newline == string::npos || last_newline < data_offset) {
+		return;
+	}
+	auto data_end = last_newline + 1;
+
+	auto file_idx = state.files.size();
+	state.files.push_back(path);
+	idx_t line_start = data_offset;
+	while (line_start < data_end) {
+		auto line_end = data.find('\n', line_start);
+		auto line_length = line_end - line_start;
+		if (line_length > 0 && data[line_end - 1] == '\r') {
+			line_length--;
+		}
+		auto file_offset = response.data_start + line_start;
+		if (!(bind_data.header && file_offset == 0)) {
+			state.records.push_back({file_idx, line_start, line_length});
+		}
+		line_start = line_end + 1;
+	}
+
+	cursor.offset = response.data_start + data_end;
+	cursor.etag = response.etag;
+	auto verify_bytes = MinValue<idx_t>(TAIL_VERIFY_BYTES, data_end);
+	cursor.tail_bytes = data.substr(data_end - verify_bytes, verify_bytes);
+	state.data.push_back(std::move(response.data));
+	state.data_start.push_back(response.data_start);
+
+	update.cursor = std::move(cursor);
+	state.updates.push_back(std::move(update));
+}
+
+static void WebDAVTailFunction(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &state = data_p.global_state->Cast<WebDAVTailState>();
+	auto &bind_data = data_p.bind_data->Cast<WebDAVTailBindData>();
+	if (!state.fetched) {
+		state.fetched = true;
+		auto opener = ClientData::Get(context).file_opener.get();
+		// GlobBatch rather than Glob: tail reads bypass the file cache, so there is nothing to prefetch for
+		for (auto &file : bind_data.info.fs.GlobBatch({bind_data.pattern}, opener)[0]) {
+			FetchTail(context, bind_data, file.path, state);
+		}
+	}
+
+	if (state.record_idx == state.records.size()) {
+		// Only reached when the consumer asked for more after the last record, i.e. not when a LIMIT stopped the scan
+		if (!state.staged) {
+			state.staged = true;
+			auto &transaction = WebDAVTailTransaction::Get(context, bind_data.info);
+			for (auto &update : state.updates) {
+				transaction.Stage(std::move(update));
+			}
+		}
+		output.SetCardinality(0);
+		return;
+	}
+
+	idx_t count = 0;
+	auto filenames = FlatVector::GetData<string_t>(output.data[0]);
+	auto offsets = FlatVector::GetData<uint64_t>(output.data[1]);
+	auto lines = FlatVector::GetData<string_t>(output.data[2]);
+	while (state.record_idx < state.records.size() && count < STANDARD_VECTOR_SIZE) {
+		auto &record = state.records[state.record_idx++];
+		auto &data = state.data[record.file_idx];
+		filenames[count] = StringVector::AddString(output.data[0], state.files[record.file_idx]);
+		offsets[count] = state.data_start[record.file_idx] + record.offset;
+		lines[count] = StringVector::AddString(output.data[2], data.data() + record.offset, record.length);
+		count++;
+	}
+	output.SetCardinality(count);
+}
+
+//===--------------------------------------------------------------------===//
+// webdav_cache_status
+//===--------------------------------------------------------------------===//
+struct WebDAVCacheStatusBindData : public TableFunctionData {
+	WebDAVCacheStatusBindData(WebDAVFileSystem &fs_p, vector<string> patterns_p)
+	    : fs(fs_p), patterns(std::move(patterns_p)) {
+	}
+
+	WebDAVFileSystem &fs;
+	vector<string> patterns;
+};
+
+struct WebDAVCacheStatusState : public GlobalTableFunctionState {
+	bool fetched = false;
+	vector<WebDAVMatchedFile> files;
+	idx_t offset = 0;
+};
+
+static unique_ptr<FunctionData> WebDAVCacheStatusBind(ClientContext &context, TableFunctionBindInput &input,
+                                                      vector<LogicalType> &return_types, vector<string> &names) {
+	auto patterns = GetPatternsArgument(input.inputs[0], "webdav_cache_status");
+
+	names = {"filename", "file_size", "cached_bytes", "cached_fraction"};
+	return_types = {LogicalType::VARCHAR, LogicalType::UBIGINT, LogicalType::UBIGINT, LogicalType::DOUBLE};
+
+	auto &info = input.info->Cast<WebDAVFunctionInfo>();
+	return make_uniq<WebDAVCacheStatusBindData>(info.fs, std::move(patterns));
+}
+
+static unique_ptr<GlobalTableFunctionState> WebDAVCacheStatusInit(ClientContext &context,
+                                                                  TableFunctionInitInput &input) {
+	return make_uniq<WebDAVCacheStatusState>();
+}
+
+static double CachedFraction(const WebDAVMatchedFile &file) {
+	return file.file_size == 0 ? 1.0 : static_cast<double>(file.cached_bytes) / static_cast<double>(file.file_size);
+}
+
+static void WebDAVCacheStatusFunction(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &state = data_p.global_state->Cast<WebDAVCacheStatusState>();
+	auto &bind_data = data_p.bind_data->Cast<WebDAVCacheStatusBindData>();
+	if (!state.fetched) {
+		state.fetched = true;
+		state.files = GetMatchedFiles(context, bind_data.fs, bind_data.patterns);
+		// Best cached first, so the list can be passed on to a scan that then starts with the local data
+		std::stable_sort(state.files.begin(), state.files.end(),
+		                 [](const WebDAVMatchedFile &a, const WebDAVMatchedFile &b) {
+			                 return CachedFraction(a) > CachedFraction(b);
+		                 });
+	}
+
+	idx_t count = 0;
+	while (state.offset < state.files.size() && count < STANDARD_VECTOR_SIZE) {
+		auto &file = state.files[state.offset++];
+		output.SetValue(0, count, Value(file.path));
+		output.SetValue(1, count, Value::UBIGINT(file.file_size));
+		output.SetValue(2, count, Value::UBIGINT(file.cached_bytes));
+		output.SetValue(3, count, Value::DOUBLE(CachedFraction(file)));
+		count++;
+	}
+	output.SetCardinality(count);
+}
+
+//===--------------------------------------------------------------------===//
+// webdav_sync_stats
+//===--------------------------------------------------------------------===//
+struct WebDAVSyncStatsBindData : public TableFunctionData {
+	explicit WebDAVSyncStatsBindData(WebDAVFileSystem &fs_p) : fs(fs_p) {
+	}
+
+	WebDAVFileSystem &fs;
+};
+
+struct WebDAVSyncStatsState : public GlobalTableFunctionState {
+	bool fetched = false;
+	vector<pair<string, WebDAVSyncStats>> files;
+	idx_t offset = 0;
+};
+
+static unique_ptr<FunctionData> WebDAVSyncStatsBind(ClientContext &context, TableFunctionBindInput &input,
+                                                    vector<LogicalType> &return_types, vector<string> &names) {
+	names = {"filename", "syncs", "full_uploads", "partial_updates", "bytes_uploaded"};
+	return_types = {LogicalType::VARCHAR, LogicalType::UBIGINT, LogicalType::UBIGINT, LogicalType::UBIGINT,
+	                LogicalType::UBIGINT};
+
+	auto &info = input.info->Cast<WebDAVFunctionInfo>();
+	return make_uniq<WebDAVSyncStatsBindData>(info.fs);
+}
+
+static unique_ptr<GlobalTableFunctionState> WebDAVSyncStatsInit(ClientContext &context, TableFunctionInitInput &input) {
+	return make_uniq<WebDAVSyncStatsState>();
+}
+
+static void WebDAVSyncStatsFunction(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &state = data_p.global_state->Cast<WebDAVSyncStatsState>();
+	auto &bind_data = data_p.bind_data->Cast<WebDAVSyncStatsBindData>();
+	if (!state.fetched) {
+		state.fetched = true;
+		for (auto &entry : bind_data.fs.GetSyncStats()) {
+			state.files.push_back(entry);
+		}
+		std::sort(state.files.begin(), state.files.end(),
+		          [](const pair<string, WebDAVSyncStats> &a, const pair<string, WebDAVSyncStats> &b) {
+			          return a.first < b.first;
+		          });
+	}
+
+	idx_t count = 0;
+	while (state.offset < state.files.size() && count < STANDARD_VECTOR_SIZE) {
+		auto &file = state.files[state.offset++];
+		output.SetValue(0, count, Value(file.first));
+		output.SetValue(1, count, Value::UBIGINT(file.second.syncs));
+		output.SetValue(2, count, Value::UBIGINT(file.second.full_uploads));
+		output.SetValue(3, count, Value::UBIGINT(file.second.partial_updates));
+		output.SetValue(4, count, Value::UBIGINT(file.second.bytes_uploaded));
+		count++;
+	}
+	output.SetCardinality(count);
+}
+
+void WebDAVFunctions::Register(ExtensionLoader &loader, WebDAVFileSystem &fs) {
+	auto info = make_shared_ptr<WebDAVFunctionInfo>(fs);
+
+	TableFunctionSet scan_estimate("webdav_scan_estimate");
+	for (auto &type : {LogicalType::VARCHAR, LogicalType::LIST(LogicalType::VARCHAR)}) {
+		TableFunction function({type}, WebDAVScanEstimateFunction, WebDAVScanEstimateBind, WebDAVScanEstimateInit);
+		function.function_info = info;
+		scan_estimate.AddFunction(function);
+	}
+	loader.RegisterFunction(scan_estimate);
+
+	TableFunctionSet cache_status("webdav_cache_status");
+	for (auto &type : {LogicalType::VARCHAR, LogicalType::LIST(LogicalType::VARCHAR)}) {
+		TableFunction function({type}, WebDAVCacheStatusFunction, WebDAVCacheStatusBind, WebDAVCacheStatusInit);
+		function.function_info = info;
+		cache_status.AddFunction(function);
+	}
+	loader.RegisterFunction(cache_status);
+
+	TableFunction tail("webdav_tail", {LogicalType::VARCHAR}, WebDAVTailFunction, WebDAVTailBind, WebDAVTailInit);
+	tail.named_parameters["header"] = LogicalType::BOOLEAN;
+	tail.named_parameters["reset"] = LogicalType::BOOLEAN;
+	tail.function_info = info;
+	loader.RegisterFunction(tail);
+
+	TableFunction sync_stats("webdav_sync_stats", {}, WebDAVSyncStatsFunction, WebDAVSyncStatsBind,
+	                         WebDAVSyncStatsInit);
+	sync_stats.function_info = info;
+	loader.RegisterFunction(sync_stats);
+}
+
+} // namespace duckdb
@@ -0,0 +1,258 @@
+#include "webdav_task_queue.hpp"
+
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/storage/caching_file_system.hpp"
+
+#include <algorithm>
+
+namespace duckdb {
+
+//! Set on the worker threads of every queue
+static thread_local bool in_background_task = false;
+
+WebDAVTaskQueue::~WebDAVTaskQueue() {
+	{
+		lock_guard<mutex> guard(lock);
+		shutdown = true;
+	}
+	task_available.notify_all();
+	// Workers finish the remaining tasks before exiting, so no upload is silently dropped
+	for (auto &worker : workers) {
+		if (worker.joinable()) {
+			worker.join();
+		}
+	}
+}
+
+void WebDAVTaskQueue::SetThreadCount(idx_t thread_count_p) {
+	lock_guard<mutex> guard(lock);
+	thread_count = MaxValue<idx_t>(thread_count, thread_count_p);
+}
+
+void WebDAVTaskQueue::Schedule(const string &path, std::function<void()> task) {
+	{
+		lock_guard<mutex> guard(lock);
+		tasks.push_back({path, std::move(task)});
+		pending_paths.push_back(path);
+		// Start workers lazily, up to the configured thread count
+		if (workers.size() < thread_count && workers.size() < pending_paths.size()) {
+			workers.emplace_back([this]() { WorkerLoop(); });
+		}
+	}
+	task_available.notify_one();
+}
+
+void WebDAVTaskQueue::WorkerLoop() {
+	in_background_task = true;
+	while (true) {
+		PendingTask current;
+		{
+			std::unique_lock<mutex> guard(lock);
+			task_available.wait(guard, [this]() { return shutdown || !tasks.empty(); });
+			if (tasks.empty()) {
+				// shutting down and nothing left to do
+				return;
+			}
+			current = std::move(tasks.front());
+			tasks.pop_front();
+		}
+
+		ErrorData error;
+		try {
+			current.task();
+		} catch (std::exception &ex) {
+			error = ErrorData(ex);
+		} catch (...) { // LCOV_EXCL_START
+			error = ErrorData("Unknown error in WebDAV background task for " + current.path);
+		} // LCOV_EXCL_STOP
+
+		{
+			lock_guard<mutex> guard(lock);
+			if (error.HasError()) {
+				errors.push_back({current.path, std::move(error)});
+			}
+			for (auto it = pending_paths.begin(); it != pending_paths.end(); it++) {
+				if (*it == current.path) {
+					pending_paths.erase(it);
+					break;
+				}
+			}
+		}
+		task_finished.notify_all();
+	}
+}
+
+bool WebDAVTaskQueue::HasPendingLocked(const string &prefix) {
+	for (auto &path : pending_paths) {
+		if (StringUtil::StartsWith(path, prefix)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+ErrorData WebDAVTaskQueue::TakeErrorLocked() {
+	// Background tasks (e.g. prefetches opening files) must not consume errors meant for the user's statements
+	if (in_background_task) {
+		return ErrorData();
+	}
+	for (auto &entry : errors) {
+		if (!entry.raised) {
+			entry.raised = true;
+			return entry.error;
+		}
+	}
+	return ErrorData();
+}
+
+void WebDAVTaskQueue::WaitInternal(const string &prefix, bool throw_errors) {
+	std::unique_lock<mutex> guard(lock);
+	task_finished.wait(guard, [&]() { return !HasPendingLocked(prefix); });
+	if (!throw_errors) {
+		return;
+	}
+	auto error = TakeErrorLocked();
+	guard.unlock();
+
+	if (error.HasError()) {
+		error.Throw();
+	}
+}
+
+void WebDAVTaskQueue::Wait(const string &prefix) {
+	WaitInternal(prefix, true);
+}
+
+void WebDAVTaskQueue::RaiseErrors() {
+	ErrorData error;
+	{
+		lock_guard<mutex> guard(lock);
+		error = TakeErrorLocked();
+	}
+	if (error.HasError()) {
+		error.Throw();
+	}
+}
+
+void WebDAVTaskQueue::Drain() {
+	std::unique_lock<mutex> guard(lock);
+	task_finished.wait(guard, [&]() { return pending_paths.empty(); });
+	errors.clear();
+}
+
+void WebDAVTaskQueue::Cancel() {
+	std::unique_lock<mutex> guard(lock);
+	for (auto &task : tasks) {
+		for (auto it = pending_paths.begin(); it != pending_paths.end(); it++) {
+			if (*it == task.path) {
+				pending_paths.erase(it);
+				break;
+			}
+		}
+	}
+	tasks.clear();
+	task_finished.wait(guard, [&]() { return pending_paths.empty(); });
+}
+
+shared_ptr<WebDAVTaskQueue> WebDAVTaskQueue::GetOrCreate(optional_ptr<FileOpener> opener, idx_t thread_count) {
+	auto client_context = FileOpener::TryGetClientContext(opener);
+	if (!client_context) {
+		return nullptr;
+	}
+	auto queue = client_context->registered_state->GetOrCreate<WebDAVTaskQueue>("webdav_task_queue", thread_count);
+	queue->SetThreadCount(thread_count);
+	return queue;
+}
+
+shared_ptr<WebDAVTaskQueue> WebDAVTaskQueue::TryGet(optional_ptr<FileOpener> opener) {
+	auto client_context = FileOpener::TryGetClientContext(opener);
+	if (!client_context) {
+		return nullptr;
+	}
+	return client_context->registered_state->Get<WebDAVTaskQueue>("webdav_task_queue");
+}
+
+WebDAVPrefetcher::~WebDAVPrefetcher() {
+	cancelled = true;
+	// the queue joins its workers when it is destroyed
+}
+
+void WebDAVPrefetcher::Cancel() {
+	{
+		lock_guard<mutex> guard(lock);
+		glob_results.clear();
+	}
+	cancelled = true;
+	queue->Drain();
+	cancelled = false;
+}
+
+void WebDAVPrefetcher::Prefetch(ClientContext &context, const vector<OpenFileInfo> &files,
+                                const unordered_map<string, idx_t> &cached_bytes, idx_t max_file_size) {
+	auto caching_fs = CachingFileSystem::Get(context);
+	// Scans read the files in listing order: prefetch from the end so both meet in the middle instead of fetching the
+	// same files at the same time
+	for (auto it = files.rbegin(); it != files.rend(); it++) {
+		auto &file = *it;
+		if (!file.extended_info) {
+			continue;
+		}
+		auto size_entry = file.extended_info->options.find("file_size");
+		if (size_entry == file.extended_info->options.end()) {
+			continue;
+		}
+		auto file_size = size_entry->second.GetValue<uint64_t>();
+		auto cached_entry = cached_bytes.find(file.path);
+		if (file_size == 0 || (cached_entry != cached_bytes.end() && cached_entry->second >= file_size)) {
+			continue;
+		}
+		// Scans with projection or filter pushdown skip most of a large Parquet file, but always read its footer
+		idx_t length = file_size;
+		if (file_size > max_file_size) {
+			if (!StringUtil::EndsWith(StringUtil::Lower(file.path), ".parquet")) {
+				continue;
+			}
+			length = MinValue<idx_t>(file_size, FOOTER_PREFETCH_SIZE);
+		}
+		idx_t location = file_size - length;
+		queue->Schedule(file.path, [this, caching_fs, file, length, location]() mutable {
+			if (cancelled) {
+				return;
+			}
+			auto handle = caching_fs.OpenFile(file, FileFlags::FILE_FLAGS_READ);
+			data_ptr_t buffer;
+			handle->Read(buffer, length, location);
+		});
+	}
+}
+
+void WebDAVPrefetcher::AddGlobResult(vector<OpenFileInfo> files) {
+	lock_guard<mutex> guard(lock);
+	glob_results.push_back(std::move(files));
+}
+
+vector<OpenFileInfo> WebDAVPrefetcher::TakeGlobResult(const string &path) {
+	lock_guard<mutex> guard(lock);
+	for (auto it = glob_results.begin(); it != glob_results.end(); it++) {
+		auto &files = *it;
+		auto entry = std::find_if(files.begin(), files.end(),
+		                          [&](const OpenFileInfo &file) { return file.path == path; });
+		if (entry == files.end()) {
+			continue;
+		}
+		// The opened file is fetched by the scan itself
+		files.erase(entry);
+		auto result = std::move(files);
+		glob_results.erase(it);
+		return result;
+	}
+	return {};
+}
+
+shared_ptr<WebDAVPrefetcher> WebDAVPrefetcher::GetOrCreate(ClientContext &context, idx_t thread_count) {
+	auto prefetcher = context.registered_state->GetOrCreate<WebDAVPrefetcher>("webdav_prefetcher", thread_count);
+	prefetcher->queue->SetThreadCount(thread_count);
+	return prefetcher;
+}
+
+} // namespace duckdb
@@ -14,9 +14,11 @@
 #include "duckdb/common/string_util.hpp"
 #include "duckdb/function/scalar/string_common.hpp"
 #include "duckdb/main/secret/secret_manager.hpp"
+#include "duckdb/storage/external_file_cache.hpp"
 #include "httpfs_client.hpp"
 #include "httpfs_curl_client.hpp"
 
+#include <chrono>
 #include <fstream>
 #include <cstdlib>
 #include <unistd.h>
@@ -46,6 +48,27 @@ WebDAVFileHandle::~WebDAVFileHandle() {
 
 void WebDAVFileHandle::Close() {
 	WEBDAV_DEBUG_LOG("[WebDAV] Close called for: %s\n", path.c_str());
+	if (block_store) {
+		// Only FileSync uploads: DuckDB syncs at every checkpoint and WAL flush, and Close runs from cleanup paths where
+		// a failing request must not replace the original error or escape a destructor
+		if (block_store->HasUnsyncedChanges() && logger) {
+			DUCKDB_LOG_WARN(logger, "Closing '%s' with changes that were never synced, they are not uploaded", path);
+		}
+		return;
+	}
+	if (upload_queue && (buffer_dirty || using_temp_file)) {
+		// Upload in the background so the writer can move on to the next file. A failed upload is raised by the next
+		// file this client closes or opens.
+		upload_queue->RaiseErrors();
+		auto pending = DetachPendingUpload();
+		bool debug_enabled = g_webdav_debug_enabled;
+		upload_queue->Schedule(path, [pending, debug_enabled]() {
+			g_webdav_debug_enabled = debug_enabled;
+			pending->FlushBuffer();
+		});
+		WEBDAV_DEBUG_LOG("[WebDAV] Close: scheduled background upload for: %s\n", path.c_str());
+		return;
+	}
 	FlushBuffer();
 
 	// Clean up temp file after successful flush
@@ -56,6 +79,27 @@ void WebDAVFileHandle::Close() {
 	}
 }
 
+shared_ptr<WebDAVFileHandle> WebDAVFileHandle::DetachPendingUpload() {
+	OpenFileInfo file(path);
+	auto params_copy = make_uniq<HTTPFSParams>(http_params);
+	auto pending =
+	    make_shared_ptr<WebDAVFileHandle>(file_system, file, flags, std::move(params_copy), auth_params, curl_util);
+
+	// The new handle is never initialized, so it takes the logger over as well. It owns the data (and removes the
+	// temp file when it is destroyed).
+	pending->logger = logger;
+	pending->write_buffer = std::move(write_buffer);
+	pending->buffer_dirty = buffer_dirty;
+	pending->temp_file_path = std::move(temp_file_path);
+	pending->using_temp_file = using_temp_file;
+
+	write_buffer.clear();
+	buffer_dirty = false;
+	temp_file_path.clear();
+	using_temp_file = false;
+	return pending;
+}
+
 void WebDAVFileHandle::FlushBuffer() {
 	if (!buffer_dirty && !using_temp_file) {
 		WEBDAV_DEBUG_LOG("[WebDAV] FlushBuffer: nothing to flush (dirty=%d, using_temp=%d)\n", buffer_dirty,
@@ -136,10 +180,61 @@ void WebDAVFileHandle::FlushBuffer() {
 }
 
 void WebDAVFileHandle::Initialize(optional_ptr<FileOpener> opener) {
+	if (UsesBlockStore()) {
+		InitializeBlockStore(opener);
+		return;
+	}
 	HTTPFileHandle::Initialize(opener);
 	// Set thread-local debug flag from settings
 	auto &httpfs_params = dynamic_cast<HTTPFSParams &>(http_params);
 	g_webdav_debug_enabled = httpfs_params.webdav_debug_logging;
+
+	// Inside an explicit transaction the statement has no commit at its end that could wait for the upload, so the
+	// file is uploaded on close and a failure fails the statement that wrote it
+	auto client_context = FileOpener::TryGetClientContext(opener);
+	if (flags.OpenForWriting() && httpfs_params.webdav_upload_threads > 0 && client_context &&
+	    client_context->transaction.IsAutoCommit()) {
+		upload_queue = WebDAVTaskQueue::GetOrCreate(opener, httpfs_params.webdav_upload_threads);
+	}
+	if (!flags.OpenForWriting()) {
+		file_system.Cast<WebDAVFileSystem>().StartPrefetch(path, opener);
+	}
+}
+
+void WebDAVFileHandle::InitializeBlockStore(optional_ptr<FileOpener> opener) {
+	g_webdav_debug_enabled = http_params.webdav_debug_logging;
+	http_params.state = HTTPState::TryGetState(opener);
+	if (!http_params.state) {
+		http_params.state = make_shared_ptr<HTTPState>();
+	}
+	if (opener) {
+		TryAddLogger(*opener);
+	}
+
+	// HEAD for size and ETag. A missing file is accepted when it may be created, and leaves the handle uninitialized.
+	LoadFileInfo();
+	bool remote_exists = initialized;
+	initialized = true;
+	WEBDAV_DEBUG_LOG("[WebDAV] InitializeBlockStore: %s exists=%d size=%llu etag=%s\n", path.c_str(), remote_exists,
+	                 (unsigned long long)length, etag.c_str());
+
+	auto &hfs = file_system.Cast<HTTPFileSystem>();
+	auto current_cache = hfs.TryGetMetadataCache(opener);
+	if (current_cache) {
+		current_cache->Erase(path);
+	}
+
+	// A create-new open starts from an empty file instead of inheriting the remote bytes
+	bool overwrite = flags.OverwriteExistingFile();
+	block_store = make_uniq<WebDAVBlockStore>(*this, length, remote_exists, etag, overwrite);
+	if (overwrite) {
+		length = 0;
+	}
+	// The block store checks the ETag itself: the one of the handle would fail range requests after our own uploads
+	etag.clear();
+	if (flags.OpenForAppending()) {
+		file_offset = length;
+	}
 }
 
 unique_ptr<HTTPClient> WebDAVFileHandle::CreateClient() {
@@ -358,6 +453,13 @@ duckdb::unique_ptr<HTTPFileHandle> WebDAVFileSystem::CreateHandle(const OpenFile
 	OpenFileInfo converted_file = file;
 	converted_file.path = converted_url;
 
+	// Uploads of files closed earlier in this client may still be running: let them land before touching the path, and
+	// report the ones that failed
+	auto upload_queue = WebDAVTaskQueue::TryGet(opener);
+	if (upload_queue) {
+		upload_queue->Wait(converted_url);
+	}
+
 	// Always use HTTPFSCurlUtil to ensure CURL-based HTTP client for custom methods
 	auto curl_util = make_shared_ptr<HTTPFSCurlUtil>();
 	WEBDAV_DEBUG_LOG("[WebDAV] CreateHandle: Using http_util: %s\n", curl_util->GetName().c_str());
@@ -381,11 +483,13 @@ duckdb::unique_ptr<HTTPResponse> WebDAVFileSystem::PropfindRequest(FileHandle &h
 
 	// Basic PROPFIND request body
 	string propfind_body = "<?xml version=\"1.0\" encoding=\"utf-8\"?>"
-	                       "<D:propfind xmlns:D=\"DAV:\">"
+	                       "<D:propfind xmlns:D=\"DAV:\" xmlns:CS=\"http://calendarserver.org/ns/\">"
 	                       "<D:prop>"
 	                       "<D:resourcetype/>"
 	                       "<D:getcontentlength/>"
 	                       "<D:getlastmodified/>"
+	                       "<D:getetag/>"
+	                       "<CS:getctag/>"
 	                       "</D:prop>"
 	                       "</D:propfind>";
 
@@ -456,6 +560,26 @@ duckdb::unique_ptr<HTTPResponse> WebDAVFileSystem::MkcolRequest(FileHandle &hand
 	return response;
 }
 
+duckdb::unique_ptr<HTTPResponse> WebDAVFileSystem::OptionsRequest(FileHandle &handle, string url,
+                                                                  HTTPHeaders header_map) {
+	auto &wfh = handle.Cast<WebDAVFileHandle>();
+	AddAuthHeaders(header_map, wfh.auth_params);
+	return CustomRequest(handle, url, header_map, "OPTIONS", nullptr, 0);
+}
+
+duckdb::unique_ptr<HTTPResponse> WebDAVFileSystem::PatchRequest(FileHandle &handle, string url, HTTPHeaders header_map,
+                                                                char *buffer_in, idx_t buffer_in_len) {
+	WEBDAV_DEBUG_LOG("[WebDAV] PatchRequest called for URL: %s (%llu bytes, %s)\n", url.c_str(),
+	                 (unsigned long long)buffer_in_len, header_map.GetHeaderValue("X-Update-Range").c_str());
+
+	auto &wfh = handle.Cast<WebDAVFileHandle>();
+	AddAuthHeaders(header_map, wfh.auth_params);
+	auto response = CustomRequest(handle, url, header_map, "PATCH", buffer_in, buffer_in_len);
+
+	WEBDAV_DEBUG_LOG("[WebDAV] PatchRequest: Got response %d\n", static_cast<int>(response->status));
+	return response;
+}
+
 duckdb::unique_ptr<HTTPResponse> WebDAVFileSystem::MoveRequest(FileHandle &handle, string source_url, string dest_url,
                                                                HTTPHeaders header_map) {
 	WEBDAV_DEBUG_LOG("[WebDAV] MoveRequest called: %s -> %s\n", source_url.c_str(), dest_url.c_str());
@@ -485,7 +609,13 @@ duckdb::unique_ptr<HTTPResponse> WebDAVFileSystem::HeadRequest(FileHandle &handl
 duckdb::unique_ptr<HTTPResponse> WebDAVFileSystem::GetRequest(FileHandle &handle, string url, HTTPHeaders header_map) {
 	auto &wfh = handle.Cast<WebDAVFileHandle>();
 	AddAuthHeaders(header_map, wfh.auth_params);
-	return HTTPFileSystem::GetRequest(handle, url, header_map);
+	auto start = std::chrono::steady_clock::now();
+	auto response = HTTPFileSystem::GetRequest(handle, url, header_map);
+	if (response && response->status == HTTPStatusCode::OK_200) {
+		RecordTransfer(url, wfh.length,
+		               std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+	}
+	return response;
 }
 
 duckdb::unique_ptr<HTTPResponse> WebDAVFileSystem::GetRangeRequest(FileHandle &handle, string url,
@@ -493,7 +623,150 @@ duckdb::unique_ptr<HTTPResponse> WebDAVFileSystem::GetRangeRequest(FileHandle &h
                                                                    char *buffer_out, idx_t buffer_out_len) {
 	auto &wfh = handle.Cast<WebDAVFileHandle>();
 	AddAuthHeaders(header_map, wfh.auth_params);
-	return HTTPFileSystem::GetRangeRequest(handle, url, header_map, file_offset, buffer_out, buffer_out_len);
+	auto start = std::chrono::steady_clock::now();
+	auto response =
+	    HTTPFileSystem::GetRangeRequest(handle, url, header_map, file_offset, buffer_out, buffer_out_len);
+	if (response && buffer_out &&
+	    (response->status == HTTPStatusCode::PartialContent_206 || response->status == HTTPStatusCode::OK_200)) {
+		RecordTransfer(url, buffer_out_len,
+		               std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+	}
+	return response;
+}
+
+unique_ptr<WebDAVFileHandle> WebDAVFileSystem::CreateRequestHandle(const string &path,
+                                                                   optional_ptr<FileOpener> opener) {
+	OpenFileInfo file_info(path);
+	auto handle = unique_ptr_cast<HTTPFileHandle, WebDAVFileHandle>(
+	    CreateHandle(file_info, FileOpenFlags::FILE_FLAGS_READ, opener));
+	handle->http_params.state = HTTPState::TryGetState(opener);
+	return handle;
+}
+
+// Parse the first byte position of a "bytes <first>-<last>/<length>" Content-Range header
+static bool TryParseContentRangeStart(const string &content_range, idx_t &result) {
+	if (!StringUtil::StartsWith(content_range, "bytes ")) {
+		return false;
+	}
+	idx_t value = 0;
+	idx_t pos = 6;
+	for (; pos < content_range.size() && StringUtil::CharacterIsDigit(content_range[pos]); pos++) {
+		value = value * 10 + static_cast<idx_t>(content_range[pos] - '0');
+	}
+	if (pos == 6 || pos >= content_range.size() || content_range[pos] != '-') {
+		return false;
+	}
+	result = value;
+	return true;
+}
+
+WebDAVTailResponse WebDAVFileSystem::ReadTail(const string &path, idx_t offset, const string &etag,
+                                              optional_ptr<FileOpener> opener) {
+	// The GET itself tells us everything, a HEAD would only cost a round trip
+	auto handle = CreateRequestHandle(path, opener);
+	auto &wfh = *handle;
+	auto &url = wfh.path;
+
+	HTTPHeaders header_map;
+	AddAuthHeaders(header_map, wfh.auth_params);
+	if (offset > 0) {
+		header_map.Insert("Range", "bytes=" + to_string(offset) + "-");
+	}
+	if (!etag.empty()) {
+		header_map.Insert("If-None-Match", etag);
+	}
+
+	WebDAVTailResponse result;
+	auto http_client = wfh.GetClient();
+	auto start = std::chrono::steady_clock::now();
+	GetRequestInfo get_request(
+	    url, header_map, wfh.http_params,
+	    [&](const HTTPResponse &response) {
+		    if (response.status == HTTPStatusCode::RangeNotSatisfiable_416) {
+			    return true;
+		    }
+		    if (static_cast<int>(response.status) >= 400) {
+			    throw HTTPException(response, "HTTP GET error on '%s' (HTTP %d)", url,
+			                        static_cast<int>(response.status));
+		    }
+		    if (static_cast<int>(response.status) < 300) {
+			    // a redirect may have delivered part of a body already
+			    result.data.clear();
+		    }
+		    return true;
+	    },
+	    [&](const_data_ptr_t data, idx_t data_length) {
+		    result.data.append(const_char_ptr_cast(data), data_length);
+		    return true;
+	    });
+	auto response = wfh.http_params.http_util.Request(get_request, http_client);
+	wfh.StoreClient(std::move(http_client));
+
+	if (!response) {
+		throw IOException("Failed to read %s: no response", path);
+	}
+	switch (response->status) {
+	case HTTPStatusCode::NotModified_304:
+		result.not_modified = true;
+		result.data.clear();
+		result.etag = etag;
+		return result;
+	case HTTPStatusCode::RangeNotSatisfiable_416:
+		result.range_not_satisfiable = true;
+		result.data.clear();
+		return result;
+	case HTTPStatusCode::PartialContent_206:
+		if (!response->HasHeader("Content-Range") ||
+		    !TryParseContentRangeStart(response->GetHeaderValue("Content-Range"), result.data_start)) {
+			throw IOException("Failed to read %s: invalid Content-Range in partial response", path);
+		}
+		break;
+	case HTTPStatusCode::OK_200:
+		// the server ignored the range and sent the whole file
+		result.data_start = 0;
+		break;
+	default:
+		throw IOException("Failed to read %s: HTTP %d", path, static_cast<int>(response->status));
+	}
+	if (response->HasHeader("ETag")) {
+		result.etag = response->GetHeaderValue("ETag");
+	}
+	RecordTransfer(url, result.data.size(),
+	               std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+	return result;
+}
+
+void WebDAVFileSystem::RecordTransfer(const string &url, idx_t bytes, double seconds) {
+	auto host = ParseUrl(url).host;
+	lock_guard<mutex> guard(host_stats_lock);
+	auto &stats = host_stats[host];
+	stats.requests++;
+	stats.bytes += bytes;
+	stats.seconds += seconds;
+}
+
+void WebDAVFileSystem::RecordSync(const string &url, bool full_upload, idx_t partial_updates, idx_t bytes) {
+	lock_guard<mutex> guard(sync_stats_lock);
+	auto &stats = sync_stats[url];
+	stats.syncs++;
+	stats.full_uploads += full_upload ? 1 : 0;
+	stats.partial_updates += partial_updates;
+	stats.bytes_uploaded += bytes;
+}
+
+unordered_map<string, WebDAVSyncStats> WebDAVFileSystem::GetSyncStats() {
+	lock_guard<mutex> guard(sync_stats_lock);
+	return sync_stats;
+}
+
+bool WebDAVFileSystem::TryGetHostStats(const string &host, WebDAVHostStats &result) {
+	lock_guard<mutex> guard(host_stats_lock);
+	auto entry = host_stats.find(host);
+	if (entry == host_stats.end() || entry->second.requests == 0) {
+		return false;
+	}
+	result = entry->second;
+	return true;
 }
 
 duckdb::unique_ptr<HTTPResponse> WebDAVFileSystem::PutRequest(FileHandle &handle, string url, HTTPHeaders header_map,
@@ -974,6 +1247,12 @@ bool WebDAVFileSystem::DirectoryExists(const string &directory, optional_ptr<Fil
 
 void WebDAVFileSystem::Write(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) {
 	auto &wfh = handle.Cast<WebDAVFileHandle>();
+	if (wfh.block_store) {
+		wfh.block_store->Write(buffer, NumericCast<idx_t>(nr_bytes), location);
+		wfh.length = wfh.block_store->GetSize();
+		wfh.file_offset = location + nr_bytes;
+		return;
+	}
 
 	WEBDAV_DEBUG_LOG("[WebDAV] Write called for: %s, bytes: %lld, location: %llu, current_offset: %llu\n",
 	                 wfh.path.c_str(), nr_bytes, (unsigned long long)location, (unsigned long long)wfh.file_offset);
@@ -1042,59 +1321,214 @@ void WebDAVFileSystem::Write(FileHandle &handle, void *buffer, int64_t nr_bytes,
 void WebDAVFileSystem::FileSync(FileHandle &handle) {
 	auto &wfh = handle.Cast<WebDAVFileHandle>();
 	WEBDAV_DEBUG_LOG("[WebDAV] FileSync called for: %s\n", wfh.path.c_str());
+	if (wfh.block_store) {
+		// Checkpoint: upload the blocks written since the last sync
+		wfh.block_store->Sync();
+		return;
+	}
 	wfh.FlushBuffer();
 }
 
-// Helper function to parse XML and extract file paths from PROPFIND response
-static vector<OpenFileInfo> ParsePropfindResponse(const string &xml_response, const string &base_path) {
-	vector<OpenFileInfo> result;
+void WebDAVFileSystem::Read(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) {
+	auto &wfh = handle.Cast<WebDAVFileHandle>();
+	if (wfh.block_store) {
+		wfh.block_store->Read(buffer, NumericCast<idx_t>(nr_bytes), location);
+		return;
+	}
+	HTTPFileSystem::Read(handle, buffer, nr_bytes, location);
+}
 
-	// Simple XML parsing - look for <D:href> or <href> tags
-	// WebDAV PROPFIND responses contain <response> elements with <href> child elements
-	size_t pos = 0;
-	while ((pos = xml_response.find("<D:href>", pos)) != string::npos ||
-	       (pos = xml_response.find("<href>", pos)) != string::npos) {
+int64_t WebDAVFileSystem::GetFileSize(FileHandle &handle) {
+	auto &wfh = handle.Cast<WebDAVFileHandle>();
+	if (wfh.block_store) {
+		return NumericCast<int64_t>(wfh.block_store->GetSize());
+	}
+	return HTTPFileSystem::GetFileSize(handle);
+}
 
-		string tag_open = xml_response.substr(pos, 8) == "<D:href>" ? "<D:href>" : "<href>";
-		string tag_close = tag_open == "<D:href>" ? "</D:href>" : "</href>";
+void WebDAVFileSystem::Truncate(FileHandle &handle, int64_t new_size) {
+	auto &wfh = handle.Cast<WebDAVFileHandle>();
+	if (!wfh.block_store) {
+		throw NotImplementedException("Cannot truncate WebDAV file %s: it is not open for reading and writing",
+		                              wfh.path);
+	}
+	wfh.block_store->Truncate(NumericCast<idx_t>(new_size));
+	wfh.length = NumericCast<idx_t>(new_size);
+}
 
-		size_t start = pos + tag_open.length();
-		size_t end = xml_response.find(tag_close, start);
+// Decode %XX escapes in an href
+static string DecodeHref(const string &href) {
+	string decoded_href;
+	decoded_href.reserve(href.size());
+	for (size_t i = 0; i < href.length(); i++) {
+		if (href[i] == '%' && i + 2 < href.length() && StringUtil::CharacterIsHex(href[i + 1]) &&
+		    StringUtil::CharacterIsHex(href[i + 2])) {
+			decoded_href += static_cast<char>(StringUtil::GetHexValue(href[i + 1]) * 16 +
+			                                  StringUtil::GetHexValue(href[i + 2]));
+			i += 2;
+		} else {
+			decoded_href += href[i];
+		}
+	}
+	return decoded_href;
+}
 
-		if (end == string::npos) {
-			break;
+// Decode the predefined XML entities (ETags are typically sent as &quot;...&quot;)
+static string DecodeXMLText(const string &text) {
+	if (text.find('&') == string::npos) {
+		return text;
+	}
+	string result;
+	result.reserve(text.size());
+	for (size_t i = 0; i < text.size(); i++) {
+		if (text[i] == '&') {
+			static const pair<const char *, char> ENTITIES[] = {
+			    {"&amp;", '&'}, {"&lt;", '<'}, {"&gt;", '>'}, {"&quot;", '"'}, {"&apos;", '\''}};
+			bool matched = false;
+			for (auto &entity : ENTITIES) {
+				auto len = strlen(entity.first);
+				if (text.compare(i, len, entity.first) == 0) {
+					result += entity.second;
+					i += len - 1;
+					matched = true;
+					break;
+				}
+			}
+			if (matched) {
+				continue;
+			}
 		}
+		result += text[i];
+	}
+	return result;
+}
 
-		string href = xml_response.substr(start, end - start);
+vector<WebDAVPropfindEntry> WebDAVFileSystem::ParsePropfindResponse(const string &xml_response) {
+	vector<WebDAVPropfindEntry> result;
 
-		// URL decode the href
-		string decoded_href;
-		for (size_t i = 0; i < href.length(); i++) {
-			if (href[i] == '%' && i + 2 < href.length()) {
-				string hex = href.substr(i + 1, 2);
-				char ch = static_cast<char>(std::stoi(hex, nullptr, 16));
-				decoded_href += ch;
-				i += 2;
-			} else {
-				decoded_href += href[i];
-			}
+	// Minimal XML scan: servers use different namespace prefixes (<D:href>, <d:href>, <href xmlns="DAV:">, <lp1:...>)
+	// so elements are matched on their local name only
+	WebDAVPropfindEntry current;
+	bool in_response = false;
+	size_t pos = 0;
+	while ((pos = xml_response.find('<', pos)) != string::npos) {
+		auto tag_end = xml_response.find('>', pos);
+		if (tag_end == string::npos) {
+			break;
+		}
+		if (xml_response[pos + 1] == '?' || xml_response[pos + 1] == '!') {
+			pos = tag_end + 1;
+			continue;
 		}
+		bool closing = xml_response[pos + 1] == '/';
+		bool self_closing = xml_response[tag_end - 1] == '/';
+		auto name_start = pos + (closing ? 2 : 1);
+		auto name_end = xml_response.find_first_of(" \t\r\n/>", name_start);
+		string name = xml_response.substr(name_start, name_end - name_start);
+		auto colon = name.rfind(':');
+		if (colon != string::npos) {
+			name = name.substr(colon + 1);
+		}
+		name = StringUtil::Lower(name);
+		pos = tag_end + 1;
 
-		// Skip the directory itself (entries ending with /)
-		if (!StringUtil::EndsWith(decoded_href, "/")) {
-			// Extract just the path portion (remove any host/port prefix)
-			// WebDAV servers often return absolute paths like /path/to/file
-			OpenFileInfo info;
-			info.path = decoded_href;
-			result.push_back(info);
+		if (name == "response") {
+			if (closing) {
+				if (in_response && !current.href.empty()) {
+					result.push_back(std::move(current));
+				}
+				current = WebDAVPropfindEntry();
+				in_response = false;
+			} else if (!self_closing) {
+				current = WebDAVPropfindEntry();
+				in_response = true;
+			}
+			continue;
+		}
+		if (!in_response || closing) {
+			continue;
+		}
+		if (name == "collection") {
+			current.is_collection = true;
+			continue;
+		}
+		if (self_closing) {
+			continue;
 		}
 
-		pos = end + tag_close.length();
+		// Elements with text content we are interested in
+		auto text_end = xml_response.find('<', pos);
+		if (text_end == string::npos) {
+			break;
+		}
+		if (name == "href") {
+			auto href = DecodeHref(DecodeXMLText(xml_response.substr(pos, text_end - pos)));
+			// Some servers return absolute URLs: strip scheme and host
+			auto scheme_end = href.find("://");
+			if (scheme_end != string::npos) {
+				auto path_start = href.find('/', scheme_end + 3);
+				href = path_start == string::npos ? "/" : href.substr(path_start);
+			}
+			current.href = href;
+		} else if (name == "getcontentlength") {
+			auto text = xml_response.substr(pos, text_end - pos);
+			StringUtil::Trim(text);
+			idx_t length = 0;
+			bool valid = !text.empty();
+			for (auto c : text) {
+				if (c < '0' || c > '9') {
+					valid = false;
+					break;
+				}
+				length = length * 10 + static_cast<idx_t>(c - '0');
+			}
+			if (valid) {
+				current.content_length = length;
+				current.has_content_length = true;
+			}
+		} else if (name == "getlastmodified") {
+			current.last_modified = DecodeXMLText(xml_response.substr(pos, text_end - pos));
+			StringUtil::Trim(current.last_modified);
+		} else if (name == "getetag") {
+			current.etag = DecodeXMLText(xml_response.substr(pos, text_end - pos));
+			StringUtil::Trim(current.etag);
+		} else if (name == "getctag") {
+			current.ctag = DecodeXMLText(xml_response.substr(pos, text_end - pos));
+			StringUtil::Trim(current.ctag);
+		}
 	}
 
+	// Some servers mark collections only by the trailing slash
+	for (auto &entry : result) {
+		if (StringUtil::EndsWith(entry.href, "/")) {
+			entry.is_collection = true;
+		}
+	}
 	return result;
 }
 
+// Build the OpenFileInfo of a listed file, carrying the listing metadata in the extended info
+static OpenFileInfo ToOpenFileInfo(const string &path, const WebDAVPropfindEntry &entry) {
+	OpenFileInfo info(path);
+	if (entry.has_content_length || !entry.last_modified.empty() || !entry.etag.empty()) {
+		info.extended_info = make_shared_ptr<ExtendedOpenFileInfo>();
+		auto &options = info.extended_info->options;
+		if (entry.has_content_length) {
+			options["file_size"] = Value::UBIGINT(entry.content_length);
+		}
+		timestamp_t last_modified;
+		if (!entry.last_modified.empty() &&
+		    HTTPFileSystem::TryParseLastModifiedTime(entry.last_modified, last_modified)) {
+			options["last_modified"] = Value::TIMESTAMP(last_modified);
+		}
+		// With size, modification time and ETag all known, opening the file skips the HEAD request
+		if (!entry.etag.empty()) {
+			options["etag"] = Value(entry.etag);
+		}
+	}
+	return info;
+}
+
 // Pattern matching helper (similar to S3)
 static bool Match(vector<string>::const_iterator key, vector<string>::const_iterator key_end,
                   vector<string>::const_iterator pattern, vector<string>::const_iterator pattern_end) {
@@ -1121,183 +1555,350 @@ static bool Match(vector<string>::const_iterator key, vector<string>::const_iter
 	return key == key_end && pattern == pattern_end;
 }
 
-vector<OpenFileInfo> WebDAVFileSystem::Glob(const string &glob_pattern, FileOpener *opener) {
-	WEBDAV_DEBUG_LOG("[WebDAV] Glob called for pattern: %s\n", glob_pattern.c_str());
-
-	if (!opener) {
-		// Without an opener, we can't authenticate, so just return the pattern
-		WEBDAV_DEBUG_LOG("[WebDAV] Glob: no opener, returning pattern as-is\n");
-		return {glob_pattern};
+// Whether files below the collection 'collection_path' can match the split pattern
+static bool CollectionMayMatch(const string &collection_path, const vector<string> &pattern_splits) {
+	auto key_splits = StringUtil::Split(collection_path, "/");
+	idx_t i = 0;
+	for (; i < key_splits.size(); i++) {
+		if (i >= pattern_splits.size()) {
+			return false;
+		}
+		if (pattern_splits[i] == "**") {
+			return true;
+		}
+		if (!Glob(key_splits[i].data(), key_splits[i].length(), pattern_splits[i].data(),
+		          pattern_splits[i].length())) {
+			return false;
+		}
 	}
+	// A file below the collection needs at least one more segment
+	return i < pattern_splits.size();
+}
 
-	// Parse the WebDAV URL
-	auto parsed_url = ParseUrl(glob_pattern);
-	string path = parsed_url.path;
+static string CollectionPath(const string &href) {
+	return StringUtil::EndsWith(href, "/") ? href : href + "/";
+}
 
-	// Find the first wildcard character
-	auto first_wildcard_pos = path.find_first_of("*[\\");
-	if (first_wildcard_pos == string::npos) {
-		// No wildcards, return as-is
-		return {glob_pattern};
+bool WebDAVFileSystem::ListCollection(WebDAVFileHandle &handle, const string &url, int depth,
+                                      vector<WebDAVPropfindEntry> &entries) {
+	HTTPHeaders headers;
+	auto response = PropfindRequest(handle, url, headers, depth);
+	// WebDAV PROPFIND should return 207 Multi-Status, some servers return 200 OK
+	if (!response ||
+	    (response->status != HTTPStatusCode::MultiStatus_207 && response->status != HTTPStatusCode::OK_200) ||
+	    response->body.empty()) {
+		return false;
 	}
+	entries = ParsePropfindResponse(response->body);
+	return true;
+}
 
-	// Extract the shared prefix path (up to the last '/' before the wildcard)
-	auto last_slash_before_wildcard = path.rfind('/', first_wildcard_pos);
-	string prefix_path;
-	if (last_slash_before_wildcard != string::npos) {
-		prefix_path = path.substr(0, last_slash_before_wildcard + 1);
-	} else {
-		prefix_path = "/";
+bool WebDAVFileSystem::TryGetCachedListing(const string &key, WebDAVListing &result) {
+	lock_guard<mutex> guard(listing_cache_lock);
+	auto entry = listing_cache.find(key);
+	if (entry == listing_cache.end()) {
+		return false;
 	}
+	result = entry->second;
+	return true;
+}
 
-	// Construct the base URL for listing
-	string list_url_pattern = parsed_url.http_proto + "://" + parsed_url.host + prefix_path;
+void WebDAVFileSystem::CacheListing(const string &key, WebDAVListing listing) {
+	lock_guard<mutex> guard(listing_cache_lock);
+	if (listing_cache.size() >= LISTING_CACHE_CAPACITY && listing_cache.find(key) == listing_cache.end()) {
+		listing_cache.clear();
+	}
+	listing_cache[key] = std::move(listing);
+}
 
-	// Create a file handle for the PROPFIND request
-	// Use a non-wildcard path to avoid recursive file opening
-	FileOpenerInfo info;
-	string non_wildcard_path;
-	if (StringUtil::StartsWith(glob_pattern, "storagebox://")) {
-		// Extract the username from the original pattern
-		string remainder = glob_pattern.substr(13);
-		auto slash_pos = remainder.find('/');
-		string username = remainder.substr(0, slash_pos);
-		non_wildcard_path = "storagebox://" + username + prefix_path;
-	} else if (StringUtil::StartsWith(glob_pattern, "webdav://")) {
-		non_wildcard_path = "webdav://" + parsed_url.host + prefix_path;
-	} else if (StringUtil::StartsWith(glob_pattern, "webdavs://")) {
-		non_wildcard_path = "webdavs://" + parsed_url.host + prefix_path;
-	} else {
-		non_wildcard_path = parsed_url.http_proto + "://" + parsed_url.host + prefix_path;
+bool WebDAVQueryListings::TryGet(const string &key, WebDAVListing &result) {
+	lock_guard<mutex> guard(lock);
+	auto entry = listings.find(key);
+	if (entry == listings.end()) {
+		return false;
 	}
+	result = entry->second;
+	return true;
+}
 
-	info.file_path = non_wildcard_path;
+void WebDAVQueryListings::Insert(const string &key, const WebDAVListing &listing) {
+	lock_guard<mutex> guard(lock);
+	listings[key] = listing;
+}
 
-	OpenFileInfo file_info;
-	file_info.path = non_wildcard_path;
+void WebDAVQueryListings::QueryEnd(ClientContext &context) {
+	lock_guard<mutex> guard(lock);
+	listings.clear();
+}
 
-	unique_ptr<WebDAVFileHandle> handle;
-	try {
-		auto base_handle = CreateHandle(file_info, FileOpenFlags::FILE_FLAGS_READ, opener);
-		handle = unique_ptr_cast<HTTPFileHandle, WebDAVFileHandle>(std::move(base_handle));
-		handle->Initialize(opener);
-	} catch (HTTPException &e) {
-		// If we can't create a handle, return empty result
-		return {};
+shared_ptr<WebDAVQueryListings> WebDAVQueryListings::TryGetOrCreate(optional_ptr<FileOpener> opener) {
+	auto client_context = FileOpener::TryGetClientContext(opener);
+	if (!client_context) {
+		return nullptr;
 	}
+	return client_context->registered_state->GetOrCreate<WebDAVQueryListings>("webdav_query_listings");
+}
 
-	// Make PROPFIND request to list files
-	// Note: We use depth=1 and recursively explore subdirectories
-	HTTPHeaders headers;
-	auto response = PropfindRequest(*handle, list_url_pattern, headers, 1);
-
-	// WebDAV PROPFIND should return 207 Multi-Status
-	// Some servers might return 200 OK
-	if (!response ||
-	    (response->status != HTTPStatusCode::MultiStatus_207 && response->status != HTTPStatusCode::OK_200)) {
-		// PROPFIND failed, return empty result
-		return {};
+void WebDAVFileSystem::CrawlCollection(WebDAVFileHandle &handle, const string &base_url, const string &collection_path,
+                                       const string &tag, const std::function<bool(const string &)> &descend,
+                                       optional_ptr<WebDAVQueryListings> query_listings,
+                                       vector<WebDAVPropfindEntry> &files) {
+	auto url = base_url + collection_path;
+	bool use_cache = handle.http_params.webdav_listing_cache;
+	// Listings may differ per user
+	auto cache_key = handle.auth_params.username + "@" + url;
+
+	WebDAVListing listing;
+	bool have_listing = false;
+	bool listed_in_query = query_listings && query_listings->TryGet(cache_key, listing);
+	if (listed_in_query) {
+		have_listing = true;
+	} else if (use_cache && TryGetCachedListing(cache_key, listing) && !listing.tag.empty()) {
+		auto current_tag = tag;
+		if (current_tag.empty()) {
+			// The root of the crawl: ask for the tag of the collection only
+			vector<WebDAVPropfindEntry> self;
+			if (ListCollection(handle, url, 0, self) && !self.empty()) {
+				current_tag = self[0].CollectionTag();
+			}
+		}
+		// An unchanged tag means nothing below the collection changed
+		have_listing = current_tag == listing.tag;
+		WEBDAV_DEBUG_LOG("[WebDAV] CrawlCollection: %s listing of %s\n", have_listing ? "reusing" : "refreshing",
+		                 url.c_str());
 	}
 
-	// Check if we got any response body
-	if (response->body.empty()) {
-		return {};
+	if (!have_listing) {
+		vector<WebDAVPropfindEntry> entries;
+		if (!ListCollection(handle, url, 1, entries)) {
+			return;
+		}
+		listing = WebDAVListing();
+		for (auto &entry : entries) {
+			if (entry.is_collection && CollectionPath(entry.href) == collection_path) {
+				listing.tag = entry.CollectionTag();
+			} else {
+				listing.members.push_back(std::move(entry));
+			}
+		}
+		if (use_cache && !listing.tag.empty()) {
+			CacheListing(cache_key, listing);
+		}
+	}
+	if (query_listings && !listed_in_query) {
+		query_listings->Insert(cache_key, listing);
 	}
 
-	// Parse the XML response
-	auto files = ParsePropfindResponse(response->body, prefix_path);
-	string response_body = response->body;
-
-	// For depth=1, we need to recursively explore subdirectories
-	// Collect all subdirectories from the response
-	vector<string> subdirs;
-	size_t pos = 0;
-	while ((pos = response_body.find("<D:href>", pos)) != string::npos ||
-	       (pos = response_body.find("<href>", pos)) != string::npos) {
-
-		string tag_open = response_body.substr(pos, 8) == "<D:href>" ? "<D:href>" : "<href>";
-		string tag_close = tag_open == "<D:href>" ? "</D:href>" : "</href>";
+	for (auto &member : listing.members) {
+		if (!member.is_collection) {
+			files.push_back(member);
+			continue;
+		}
+		auto member_path = CollectionPath(member.href);
+		// Guard against servers returning the collection itself under another spelling
+		if (member_path.size() <= collection_path.size() || !StringUtil::StartsWith(member_path, collection_path)) {
+			continue;
+		}
+		if (descend(member_path)) {
+			CrawlCollection(handle, base_url, member_path, member.CollectionTag(), descend, query_listings, files);
+		}
+	}
+}
 
-		size_t start = pos + tag_open.length();
-		size_t end = response_body.find(tag_close, start);
+// The URL of 'path' on the host of 'parsed_url', keeping the scheme (and storage box user) of 'original_url'
+static string ReconstructUrl(const string &original_url, const ParsedWebDAVUrl &parsed_url, const string &path) {
+	if (StringUtil::StartsWith(original_url, "storagebox://")) {
+		// Extract the username from the original pattern
+		string remainder = original_url.substr(13);
+		auto slash_pos = remainder.find('/');
+		string username = remainder.substr(0, slash_pos);
+		return "storagebox://" + username + path;
+	} else if (StringUtil::StartsWith(original_url, "webdav://")) {
+		return "webdav://" + parsed_url.host + path;
+	} else if (StringUtil::StartsWith(original_url, "webdavs://")) {
+		return "webdavs://" + parsed_url.host + path;
+	}
+	return parsed_url.http_proto + "://" + parsed_url.host + path;
+}
 
-		if (end == string::npos) {
-			break;
+// The longest common prefix of two collection paths, ending at a '/'
+static string CommonCollectionPath(const string &a, const string &b) {
+	idx_t common = 0;
+	for (idx_t i = 0; i < a.size() && i < b.size() && a[i] == b[i]; i++) {
+		if (a[i] == '/') {
+			common = i + 1;
 		}
+	}
+	return common == 0 ? "/" : a.substr(0, common);
+}
 
-		string href = response_body.substr(start, end - start);
+vector<OpenFileInfo> WebDAVFileSystem::Glob(const string &glob_pattern, FileOpener *opener) {
+	WEBDAV_DEBUG_LOG("[WebDAV] Glob called for pattern: %s\n", glob_pattern.c_str());
+	auto result = std::move(GlobBatch({glob_pattern}, opener)[0]);
+	// A single file has no other files whose scan could hide its fetch. Globs that only list files (glob(), existence
+	// checks) never open one, so nothing is fetched for them.
+	if (result.size() > 1) {
+		SchedulePrefetch(result, opener);
+	}
+	return result;
+}
 
-		// URL decode
-		string decoded_href;
-		for (size_t i = 0; i < href.length(); i++) {
-			if (href[i] == '%' && i + 2 < href.length()) {
-				string hex = href.substr(i + 1, 2);
-				char ch = static_cast<char>(std::stoi(hex, nullptr, 16));
-				decoded_href += ch;
-				i += 2;
-			} else {
-				decoded_href += href[i];
-			}
+unordered_map<string, idx_t> WebDAVFileSystem::GetCachedBytes(ClientContext &context) {
+	unordered_map<string, idx_t> result;
+	auto &cache = ExternalFileCache::Get(context);
+	for (auto &info : cache.GetCachedFileInformation()) {
+		if (info.loaded) {
+			result[info.path] += info.nr_bytes;
 		}
+	}
+	return result;
+}
 
-		// This is a directory if it ends with /
-		if (StringUtil::EndsWith(decoded_href, "/") && decoded_href != prefix_path) {
-			string subdir_url = parsed_url.http_proto + "://" + parsed_url.host + decoded_href;
-			subdirs.push_back(subdir_url);
-		}
+void WebDAVFileSystem::SchedulePrefetch(const vector<OpenFileInfo> &files, FileOpener *opener) {
+	Value thread_count;
+	if (!FileOpener::TryGetCurrentSetting(opener, "webdav_prefetch_threads", thread_count) || thread_count.IsNull() ||
+	    thread_count.GetValue<int64_t>() <= 0) {
+		return;
+	}
+	auto client_context = FileOpener::TryGetClientContext(opener);
+	if (!client_context || !ExternalFileCache::Get(*client_context).IsEnabled()) {
+		// without the external file cache there is nowhere to keep prefetched data
+		return;
+	}
+	auto prefetcher = WebDAVPrefetcher::GetOrCreate(*client_context, thread_count.GetValue<idx_t>());
+	prefetcher->AddGlobResult(files);
+}
 
-		pos = end + tag_close.length();
+void WebDAVFileSystem::StartPrefetch(const string &path, optional_ptr<FileOpener> opener) {
+	auto client_context = FileOpener::TryGetClientContext(opener);
+	if (!client_context) {
+		return;
+	}
+	auto prefetcher = client_context->registered_state->Get<WebDAVPrefetcher>("webdav_prefetcher");
+	if (!prefetcher) {
+		return;
+	}
+	auto files = prefetcher->TakeGlobResult(path);
+	if (files.empty()) {
+		return;
+	}
+	Value max_file_size_mb;
+	idx_t max_file_size = 4ULL * 1024 * 1024;
+	if (FileOpener::TryGetCurrentSetting(opener, "webdav_prefetch_max_file_size_mb", max_file_size_mb) &&
+	    !max_file_size_mb.IsNull()) {
+		max_file_size = NumericCast<idx_t>(MaxValue<int64_t>(max_file_size_mb.GetValue<int64_t>(), 0)) * 1024 * 1024;
 	}
+	prefetcher->Prefetch(*client_context, files, GetCachedBytes(*client_context), max_file_size);
+}
 
-	// Recursively list subdirectories
-	for (const auto &subdir_url : subdirs) {
-		auto subdir_response = PropfindRequest(*handle, subdir_url, headers, 1);
-		if (subdir_response && (subdir_response->status == HTTPStatusCode::MultiStatus_207 ||
-		                        subdir_response->status == HTTPStatusCode::OK_200)) {
-			auto subdir_files = ParsePropfindResponse(subdir_response->body, prefix_path);
-			files.insert(files.end(), subdir_files.begin(), subdir_files.end());
+vector<vector<OpenFileInfo>> WebDAVFileSystem::GlobBatch(const vector<string> &glob_patterns, FileOpener *opener) {
+	vector<vector<OpenFileInfo>> result(glob_patterns.size());
+
+	struct GlobPattern {
+		idx_t result_idx;
+		ParsedWebDAVUrl parsed_url;
+		string prefix_path;
+		vector<string> pattern_splits;
+	};
+	// Patterns that are crawled together: same host and same credentials
+	struct GlobGroup {
+		unique_ptr<WebDAVFileHandle> handle;
+		string base_url;
+		string root_path;
+		vector<GlobPattern> patterns;
+	};
+	vector<GlobGroup> groups;
+
+	for (idx_t i = 0; i < glob_patterns.size(); i++) {
+		auto &glob_pattern = glob_patterns[i];
+		if (!opener) {
+			// Without an opener, we can't authenticate, so just return the pattern
+			WEBDAV_DEBUG_LOG("[WebDAV] Glob: no opener, returning pattern as-is\n");
+			result[i].emplace_back(glob_pattern);
+			continue;
 		}
-	}
 
-	// Match the pattern against the file paths
-	vector<string> pattern_splits = StringUtil::Split(path, "/");
-	vector<OpenFileInfo> result;
+		// Parse the WebDAV URL
+		auto parsed_url = ParseUrl(glob_pattern);
+		string path = parsed_url.path;
 
-	for (auto &file_info : files) {
-		// Extract the path component from the href
-		string file_path = file_info.path;
+		// Find the first wildcard character
+		auto first_wildcard_pos = path.find_first_of("*[\\");
+		if (first_wildcard_pos == string::npos) {
+			// No wildcards, return as-is
+			result[i].emplace_back(glob_pattern);
+			continue;
+		}
 
-		// Remove any leading protocol/host if present
-		size_t path_start = file_path.find(parsed_url.host);
-		if (path_start != string::npos) {
-			file_path = file_path.substr(path_start + parsed_url.host.length());
+		// Extract the shared prefix path (up to the last '/' before the wildcard)
+		auto last_slash_before_wildcard = path.rfind('/', first_wildcard_pos);
+		string prefix_path;
+		if (last_slash_before_wildcard != string::npos) {
+			prefix_path = path.substr(0, last_slash_before_wildcard + 1);
+		} else {
+			prefix_path = "/";
 		}
 
-		vector<string> key_splits = StringUtil::Split(file_path, "/");
-		bool is_match = Match(key_splits.begin(), key_splits.end(), pattern_splits.begin(), pattern_splits.end());
-
-		if (is_match) {
-			// Reconstruct the full URL with the original protocol
-			string full_url;
-			if (StringUtil::StartsWith(glob_pattern, "storagebox://")) {
-				// Extract the username from the original pattern
-				string remainder = glob_pattern.substr(13);
-				auto slash_pos = remainder.find('/');
-				string username = remainder.substr(0, slash_pos);
-				full_url = "storagebox://" + username + file_path;
-			} else if (StringUtil::StartsWith(glob_pattern, "webdav://")) {
-				full_url = "webdav://" + parsed_url.host + file_path;
-			} else if (StringUtil::StartsWith(glob_pattern, "webdavs://")) {
-				full_url = "webdavs://" + parsed_url.host + file_path;
-			} else {
-				full_url = parsed_url.http_proto + "://" + parsed_url.host + file_path;
-			}
+		// Create a file handle for the PROPFIND requests
+		// Use a non-wildcard path to avoid recursive file opening
+		unique_ptr<WebDAVFileHandle> handle;
+		try {
+			handle = CreateRequestHandle(ReconstructUrl(glob_pattern, parsed_url, prefix_path), opener);
+		} catch (HTTPException &e) {
+			// If we can't create a handle, the pattern has no matches
+			continue;
+		}
 
-			file_info.path = full_url;
-			result.push_back(file_info);
+		GlobPattern pattern {i, parsed_url, prefix_path, StringUtil::Split(path, "/")};
+		string base_url = parsed_url.http_proto + "://" + parsed_url.host;
+		GlobGroup *group = nullptr;
+		for (auto &candidate : groups) {
+			if (candidate.base_url == base_url &&
+			    candidate.handle->auth_params.username == handle->auth_params.username &&
+			    candidate.handle->auth_params.password == handle->auth_params.password) {
+				group = &candidate;
+				break;
+			}
 		}
+		if (!group) {
+			groups.push_back(GlobGroup {std::move(handle), base_url, prefix_path, {}});
+			group = &groups.back();
+		}
+		group->root_path = CommonCollectionPath(group->root_path, prefix_path);
+		group->patterns.push_back(std::move(pattern));
 	}
 
+	auto query_listings = WebDAVQueryListings::TryGetOrCreate(opener);
+	for (auto &group : groups) {
+		// Crawl from the common prefix, only descending into collections that can contain matches of any pattern
+		vector<WebDAVPropfindEntry> entries;
+		CrawlCollection(
+		    *group.handle, group.base_url, group.root_path, string(),
+		    [&](const string &collection_path) {
+			    for (auto &pattern : group.patterns) {
+				    if (CollectionMayMatch(collection_path, pattern.pattern_splits)) {
+					    return true;
+				    }
+			    }
+			    return false;
+		    },
+		    query_listings.get(), entries);
+
+		// Match the file paths against every pattern of the group
+		for (auto &entry : entries) {
+			vector<string> key_splits = StringUtil::Split(entry.href, "/");
+			for (auto &pattern : group.patterns) {
+				if (!StringUtil::StartsWith(entry.href, pattern.prefix_path) ||
+				    !Match(key_splits.begin(), key_splits.end(), pattern.pattern_splits.begin(),
+				           pattern.pattern_splits.end())) {
+					continue;
+				}
+				// Reconstruct the full URL with the original protocol
+				auto full_url = ReconstructUrl(glob_patterns[pattern.result_idx], pattern.parsed_url, entry.href);
+				result[pattern.result_idx].push_back(ToOpenFileInfo(full_url, entry));
+			}
+		}
+	}
 	return result;
 }
 